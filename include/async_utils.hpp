@@ -0,0 +1,200 @@
+#pragma once
+
+#include "logger.hpp"
+#include "metrics.hpp"
+#include "types.hpp"
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/system_error.hpp>
+#include <memory>
+#include <sdbusplus/asio/connection.hpp>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace panel
+{
+namespace utils
+{
+/**
+ * @brief Make a D-Bus method call without blocking the event loop.
+ *
+ * The call is awaited by the calling coroutine, which is resumed on the event
+ * loop once the reply is received.
+ *
+ * @param[in] conn - D-Bus connection.
+ * @param[in] service - Service to call.
+ * @param[in] object - Object path.
+ * @param[in] inf - Interface of the method.
+ * @param[in] method - Method to call.
+ * @param[in] args - Arguments of the method.
+ * @return Reply of the method, if Ret is not void.
+ * @throw boost::system::system_error if the call fails.
+ */
+template <typename Ret, typename... Args>
+boost::asio::awaitable<Ret>
+    asyncMethodCall(sdbusplus::asio::connection& conn, std::string service,
+                    std::string object, std::string inf, std::string method,
+                    Args... args)
+{
+    metrics::CallTimer timer(metrics::get().getDbusCallLatency(service));
+
+    if constexpr (std::is_void_v<Ret>)
+    {
+        co_await boost::asio::async_initiate<
+            const boost::asio::use_awaitable_t<>,
+            void(boost::system::error_code)>(
+            [&](auto handler) {
+                conn.async_method_call(
+                    [handler = std::move(handler)](
+                        boost::system::error_code ec) mutable { handler(ec); },
+                    service, object, inf, method, args...);
+            },
+            boost::asio::use_awaitable);
+    }
+    else
+    {
+        co_return co_await boost::asio::async_initiate<
+            const boost::asio::use_awaitable_t<>,
+            void(boost::system::error_code, Ret)>(
+            [&](auto handler) {
+                conn.async_method_call(
+                    [handler = std::move(handler)](boost::system::error_code ec,
+                                                   Ret reply) mutable {
+                        handler(ec, std::move(reply));
+                    },
+                    service, object, inf, method, args...);
+            },
+            boost::asio::use_awaitable);
+    }
+}
+
+/** @brief Read a D-Bus property without blocking the event loop.
+ *
+ * Same as readBusProperty, errors are logged and an empty value is returned.
+ *
+ * @param[in] conn - D-Bus connection.
+ * @param[in] service - Dbus service name.
+ * @param[in] object - Dbus object to query for the property.
+ * @param[in] inf - Interface in which the property is present.
+ * @param[in] prop - Property to be queried.
+ * @return The property value.
+ */
+template <typename T>
+boost::asio::awaitable<T>
+    asyncReadBusProperty(sdbusplus::asio::connection& conn, std::string service,
+                         std::string object, std::string inf, std::string prop)
+{
+    try
+    {
+        co_return co_await asyncMethodCall<T>(
+            conn, std::move(service), std::move(object),
+            "org.freedesktop.DBus.Properties", "Get", std::move(inf),
+            std::move(prop));
+    }
+    catch (const boost::system::system_error& e)
+    {
+        log::error(log::Category::BUS, e.what());
+    }
+    co_return T{};
+}
+
+/**
+ * @brief Write a D-Bus property without blocking the event loop.
+ * @param[in] conn - D-Bus connection.
+ * @param[in] serviceName - Name of the service.
+ * @param[in] objectPath - Object path
+ * @param[in] infName - Interface name.
+ * @param[in] propertyName - Name of the property to write.
+ * @param[in] paramValue - The property value.
+ * @throw boost::system::system_error if the write fails.
+ */
+template <typename T>
+boost::asio::awaitable<void>
+    asyncWriteBusProperty(sdbusplus::asio::connection& conn,
+                          std::string serviceName, std::string objectPath,
+                          std::string infName, std::string propertyName,
+                          std::variant<T> paramValue)
+{
+    co_await asyncMethodCall<void>(
+        conn, std::move(serviceName), std::move(objectPath),
+        "org.freedesktop.DBus.Properties", "Set", std::move(infName),
+        std::move(propertyName), std::move(paramValue));
+}
+
+/**
+ * @brief Read all properties of interfaces without blocking the event loop.
+ *
+ * "GetAll" of every interface is sent at once and the replies are awaited
+ * together, so reading several properties takes one round trip. Same as
+ * asyncReadBusProperty, errors are logged and the properties of an interface
+ * that could not be read are empty.
+ *
+ * @param[in] conn - D-Bus connection.
+ * @param[in] service - Dbus service name.
+ * @param[in] interfaces - Object path and interface of each "GetAll".
+ * @return Properties of each interface, in the order given.
+ */
+boost::asio::awaitable<std::vector<types::PropertyMap>>
+    asyncGetAllProperties(sdbusplus::asio::connection& conn,
+                          std::string service,
+                          std::vector<types::ObjectInterface> interfaces);
+
+/**
+ * @brief Get the typed value of a property read by "GetAll".
+ * @param[in] properties - Properties of the interface.
+ * @param[in] name - Name of the property.
+ * @return Pointer to the value, nullptr if not present or of other type.
+ */
+template <typename T>
+const T* getProperty(const types::PropertyMap& properties,
+                     const std::string& name)
+{
+    const auto it = properties.find(name);
+    if (it == properties.end())
+    {
+        return nullptr;
+    }
+    return std::get_if<T>(&it->second);
+}
+
+/** @brief Call "GetManagedObjects" without blocking the event loop.
+ * @param[in] conn - D-Bus connection.
+ * @param[in] service - service on which the d-bus call needs to happen.
+ * @param[in] object - object path.
+ * @return returns output of "GetManagedObjects" call, empty on failure.
+ */
+boost::asio::awaitable<types::GetManagedObjects>
+    asyncGetManagedObjects(sdbusplus::asio::connection& conn,
+                           std::string service, std::string object);
+
+/**
+ * @brief Make mapper call to get boot side paths, without blocking.
+ * @param[in] conn - D-Bus connection.
+ * @return List of all image object paths.
+ * @throw boost::system::system_error if the call fails.
+ */
+boost::asio::awaitable<std::vector<std::string>>
+    asyncGetBootSidePaths(sdbusplus::asio::connection& conn);
+
+/**
+ * @brief Get next marked boot side, without blocking.
+ * @param[in] conn - D-Bus connection.
+ * @return Next selected boot side, empty if not known.
+ */
+boost::asio::awaitable<std::string>
+    asyncGetNextBootSide(sdbusplus::asio::connection& conn);
+
+/**
+ * @brief Read the values of OS IPL types, System operating mode, firmware
+ * IPL type, Hypervisor type and HMC indicator, without blocking.
+ * @param[in] conn - D-Bus connection.
+ * @return - Values of required system parameters.
+ */
+boost::asio::awaitable<types::SystemParameterValues>
+    asyncReadSystemParameters(sdbusplus::asio::connection& conn);
+} // namespace utils
+} // namespace panel
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "dbus_enums.hpp"
 #include "executor.hpp"
+#include "ipl_timeline.hpp"
 #include "panel_state_manager.hpp"
 #include "transport.hpp"
 
@@ -106,6 +108,90 @@ class PELListener
 
 }; // class PEL Listener
 
+/**
+ * @brief Listen to VPD changes.
+ *
+ * Display of function 20 is loaded again when the VPD of system or motherboard
+ * is collected or changed.
+ */
+class VpdListener
+{
+  public:
+    VpdListener(const VpdListener&) = delete;
+    VpdListener& operator=(const VpdListener&) = delete;
+    VpdListener(VpdListener&&) = delete;
+    ~VpdListener() = default;
+
+    /**
+     * @brief Constructor
+     * @param[in] con - Bus connection.
+     * @param[in] execute - pointer to Executor.
+     */
+    VpdListener(std::shared_ptr<sdbusplus::asio::connection> con,
+                std::shared_ptr<Executor> execute) :
+        conn(con),
+        executor(execute)
+    {
+    }
+
+    /**
+     * @brief Api to listen for VPD changes.
+     */
+    void listenVpdChanges();
+
+  private:
+    /* Callback to listen for inventory objects added */
+    void inventoryAddedCallBack(sdbusplus::message::message& msg);
+
+    /* Dbus connection */
+    std::shared_ptr<sdbusplus::asio::connection> conn;
+
+    /* Executor */
+    std::shared_ptr<Executor> executor;
+
+}; // class VpdListener
+
+/**
+ * @brief Listen to changes of the system parameters.
+ *
+ * Cached display of function 01 is dropped when the BIOS attributes, the
+ * settings of the operating mode or the boot side priority change.
+ */
+class SystemParameterListener
+{
+  public:
+    SystemParameterListener(const SystemParameterListener&) = delete;
+    SystemParameterListener& operator=(const SystemParameterListener&) =
+        delete;
+    SystemParameterListener(SystemParameterListener&&) = delete;
+    ~SystemParameterListener() = default;
+
+    /**
+     * @brief Constructor
+     * @param[in] con - Bus connection.
+     * @param[in] execute - pointer to Executor.
+     */
+    SystemParameterListener(std::shared_ptr<sdbusplus::asio::connection> con,
+                            std::shared_ptr<Executor> execute) :
+        conn(con),
+        executor(execute)
+    {
+    }
+
+    /**
+     * @brief Api to listen for system parameter changes.
+     */
+    void listenParameterChanges();
+
+  private:
+    /* Dbus connection */
+    std::shared_ptr<sdbusplus::asio::connection> conn;
+
+    /* Executor */
+    std::shared_ptr<Executor> executor;
+
+}; // class SystemParameterListener
+
 /**
  * @brief Progress code event handler.
  * A class to register handler for progress code property channge.
@@ -123,12 +209,14 @@ class BootProgressCode
      * @param[in] transport - pointer to transport class.
      * @param[in] con - Bus connection.
      * @param[in] execute - pointer to Executor.
+     * @param[in] timeline - pointer to IPL timeline tracker.
      */
     BootProgressCode(std::shared_ptr<Transport> transport,
                      std::shared_ptr<sdbusplus::asio::connection> con,
-                     std::shared_ptr<Executor> execute) :
+                     std::shared_ptr<Executor> execute,
+                     std::shared_ptr<IplTimeline> timeline) :
         transport(transport),
-        conn(con), executor(execute)
+        conn(con), executor(execute), iplTimeline(timeline)
     {
     }
 
@@ -154,6 +242,9 @@ class BootProgressCode
     /* Executor */
     std::shared_ptr<Executor> executor;
 
+    /* IPL timeline tracker */
+    std::shared_ptr<IplTimeline> iplTimeline;
+
 }; // class BootProgressCode
 
 /**
@@ -264,7 +355,7 @@ class SystemStatus
     bool loggingPolicy;
 
     /* Member to store power policy */
-    std::string powerPolicy;
+    types::RestorePolicy powerPolicy;
 
     /* Member to store reboot policy */
     bool rebootPolicy;
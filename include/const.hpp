@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace panel
 {
 namespace constants
@@ -10,10 +12,19 @@ static constexpr auto rainLcdDevPath = "/dev/i2c-7";
 static constexpr auto everLcdDevPath = "/dev/i2c-28";
 static constexpr auto tacomaLcdDevPath = "/dev/i2c-0";
 
-static constexpr auto devAddr = 0x5a;
+static constexpr auto rainInputDevPath =
+    "/dev/input/by-path/platform-1e78a400.i2c-bus-event-joystick";
+static constexpr auto everInputDevPath =
+    "/dev/input/by-path/platform-1e78a780.i2c-bus-event-joystick";
+static constexpr auto tacomaInputDevPath =
+    "/dev/input/by-path/platform-1e78a080.i2c-bus-event-joystick";
+
+static constexpr uint8_t devAddr = 0x5a;
 
 static constexpr auto systemDbusObj =
     "/xyz/openbmc_project/inventory/system/chassis/motherboard";
+static constexpr auto systemInventoryObj =
+    "/xyz/openbmc_project/inventory/system";
 static constexpr auto rainBaseDbusObj =
     "/xyz/openbmc_project/inventory/system/chassis/motherboard/"
     "base_op_panel_blyth";
@@ -40,6 +51,9 @@ static constexpr auto networkManagerService = "xyz.openbmc_project.Network";
 static constexpr auto networkManagerObj = "/xyz/openbmc_project/network";
 static constexpr auto locCodeIntf =
     "xyz.openbmc_project.Inventory.Decorator.LocationCode";
+static constexpr auto assetIntf =
+    "xyz.openbmc_project.Inventory.Decorator.Asset";
+static constexpr auto vsysInterface = "com.ibm.ipzvpd.VSYS";
 
 static constexpr auto tmKwdDataLength = 8;
 static constexpr auto ccinDataLength = 4;
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+namespace panel
+{
+namespace types
+{
+enum class BMCState : uint8_t
+{
+    UNKNOWN,
+    READY,
+    NOT_READY,
+    UPDATE_IN_PROGRESS,
+    QUIESCED
+};
+
+enum class PowerState : uint8_t
+{
+    UNKNOWN,
+    OFF,
+    ON,
+    TRANSITIONING_TO_OFF,
+    TRANSITIONING_TO_ON
+};
+
+enum class BootProgress : uint8_t
+{
+    UNKNOWN,
+    UNSPECIFIED,
+    PRIMARY_PROC_INIT,
+    BUS_INIT,
+    MEMORY_INIT,
+    SECONDARY_PROC_INIT,
+    PCI_INIT,
+    SYSTEM_INIT_COMPLETE,
+    SYSTEM_SETUP,
+    OS_START,
+    OS_RUNNING,
+    MOTHERBOARD_INIT
+};
+
+enum class RestorePolicy : uint8_t
+{
+    UNKNOWN,
+    NONE,
+    ALWAYS_ON,
+    ALWAYS_OFF,
+    RESTORE
+};
+
+enum class OperatingMode : uint8_t
+{
+    NORMAL,
+    MANUAL
+};
+
+/** @class EnumParser
+ * @brief Parser of the strings of a D-Bus enum.
+ *
+ * A perfect hash of the known strings is found at compile time, so a string
+ * is parsed with one hash and at most one string compare. Strings of an enum
+ * differ mostly at the end, so the hash is of the length and the last
+ * characters only.
+ */
+template <typename Enum, size_t N>
+class EnumParser
+{
+  public:
+    using Entry = std::pair<std::string_view, Enum>;
+
+    /**
+     * @brief Constructor
+     * @param[in] entries - Known strings and their values.
+     * @param[in] unknown - Value of the strings that are not known.
+     */
+    consteval EnumParser(const std::array<Entry, N>& entries, Enum unknown) :
+        entries(entries), unknown(unknown)
+    {
+        while (!fillSlots())
+        {
+            seed++;
+        }
+    }
+
+    /**
+     * @brief Parse a string of the enum.
+     * @param[in] value - String to parse.
+     * @return Value of the string, the unknown value if not known.
+     */
+    constexpr Enum parse(std::string_view value) const
+    {
+        const auto slot = slots[hash(value, seed) & (tableSize - 1)];
+        if (slot != emptySlot && entries[slot].first == value)
+        {
+            return entries[slot].second;
+        }
+        return unknown;
+    }
+
+  private:
+    /* Number of slots, a power of two with at most half of them in use. */
+    static constexpr size_t tableSize = std::bit_ceil(2 * N);
+
+    /* Slot without an entry. */
+    static constexpr uint8_t emptySlot = 0xFF;
+
+    /* Number of characters from the end that are hashed. */
+    static constexpr size_t hashedLength = 8;
+
+    static_assert(N < emptySlot, "Too many strings in the enum.");
+
+    /**
+     * @brief FNV-1a hash of the length and the last characters.
+     * @param[in] value - String to hash.
+     * @param[in] seed - Seed of the hash.
+     * @return The hash.
+     */
+    static constexpr uint32_t hash(std::string_view value, uint32_t seed)
+    {
+        uint32_t result = 2166136261u ^ seed;
+        result = (result ^ static_cast<uint32_t>(value.size())) * 16777619u;
+
+        const auto start =
+            value.size() > hashedLength ? value.size() - hashedLength : 0;
+        for (auto it = value.begin() + start; it != value.end(); ++it)
+        {
+            result = (result ^ static_cast<uint8_t>(*it)) * 16777619u;
+        }
+        return result ^ (result >> 15);
+    }
+
+    /**
+     * @brief Place the entries in the slots, using the current seed.
+     * @return false if two entries hash to the same slot.
+     */
+    consteval bool fillSlots()
+    {
+        slots.fill(emptySlot);
+        for (size_t index = 0; index < N; ++index)
+        {
+            auto& slot =
+                slots[hash(entries[index].first, seed) & (tableSize - 1)];
+            if (slot != emptySlot)
+            {
+                return false;
+            }
+            slot = static_cast<uint8_t>(index);
+        }
+        return true;
+    }
+
+    /* Known strings and their values. */
+    std::array<Entry, N> entries;
+
+    /* Value of the strings that are not known. */
+    Enum unknown;
+
+    /* Seed of the hash, found to place every entry in its own slot. */
+    uint32_t seed = 0;
+
+    /* Index of the entry in each slot. */
+    std::array<uint8_t, tableSize> slots{};
+};
+
+/* Parser of xyz.openbmc_project.State.BMC.BMCState */
+inline constexpr EnumParser<BMCState, 4> bmcStateParser{
+    {{{"xyz.openbmc_project.State.BMC.BMCState.Ready", BMCState::READY},
+      {"xyz.openbmc_project.State.BMC.BMCState.NotReady",
+       BMCState::NOT_READY},
+      {"xyz.openbmc_project.State.BMC.BMCState.UpdateInProgress",
+       BMCState::UPDATE_IN_PROGRESS},
+      {"xyz.openbmc_project.State.BMC.BMCState.Quiesced",
+       BMCState::QUIESCED}}},
+    BMCState::UNKNOWN};
+
+/* Parser of xyz.openbmc_project.State.Chassis.PowerState */
+inline constexpr EnumParser<PowerState, 4> powerStateParser{
+    {{{"xyz.openbmc_project.State.Chassis.PowerState.Off", PowerState::OFF},
+      {"xyz.openbmc_project.State.Chassis.PowerState.On", PowerState::ON},
+      {"xyz.openbmc_project.State.Chassis.PowerState.TransitioningToOff",
+       PowerState::TRANSITIONING_TO_OFF},
+      {"xyz.openbmc_project.State.Chassis.PowerState.TransitioningToOn",
+       PowerState::TRANSITIONING_TO_ON}}},
+    PowerState::UNKNOWN};
+
+/* Parser of xyz.openbmc_project.State.Boot.Progress.ProgressStages */
+inline constexpr EnumParser<BootProgress, 11> bootProgressParser{
+    {{{"xyz.openbmc_project.State.Boot.Progress.ProgressStages.Unspecified",
+       BootProgress::UNSPECIFIED},
+      {"xyz.openbmc_project.State.Boot.Progress.ProgressStages."
+       "PrimaryProcInit",
+       BootProgress::PRIMARY_PROC_INIT},
+      {"xyz.openbmc_project.State.Boot.Progress.ProgressStages.BusInit",
+       BootProgress::BUS_INIT},
+      {"xyz.openbmc_project.State.Boot.Progress.ProgressStages.MemoryInit",
+       BootProgress::MEMORY_INIT},
+      {"xyz.openbmc_project.State.Boot.Progress.ProgressStages."
+       "SecondaryProcInit",
+       BootProgress::SECONDARY_PROC_INIT},
+      {"xyz.openbmc_project.State.Boot.Progress.ProgressStages.PCIInit",
+       BootProgress::PCI_INIT},
+      {"xyz.openbmc_project.State.Boot.Progress.ProgressStages."
+       "SystemInitComplete",
+       BootProgress::SYSTEM_INIT_COMPLETE},
+      {"xyz.openbmc_project.State.Boot.Progress.ProgressStages.SystemSetup",
+       BootProgress::SYSTEM_SETUP},
+      {"xyz.openbmc_project.State.Boot.Progress.ProgressStages.OSStart",
+       BootProgress::OS_START},
+      {"xyz.openbmc_project.State.Boot.Progress.ProgressStages.OSRunning",
+       BootProgress::OS_RUNNING},
+      {"xyz.openbmc_project.State.Boot.Progress.ProgressStages."
+       "MotherboardInit",
+       BootProgress::MOTHERBOARD_INIT}}},
+    BootProgress::UNKNOWN};
+
+/* Parser of xyz.openbmc_project.Control.Power.RestorePolicy.Policy */
+inline constexpr EnumParser<RestorePolicy, 4> restorePolicyParser{
+    {{{"xyz.openbmc_project.Control.Power.RestorePolicy.Policy.None",
+       RestorePolicy::NONE},
+      {"xyz.openbmc_project.Control.Power.RestorePolicy.Policy.AlwaysOn",
+       RestorePolicy::ALWAYS_ON},
+      {"xyz.openbmc_project.Control.Power.RestorePolicy.Policy.AlwaysOff",
+       RestorePolicy::ALWAYS_OFF},
+      {"xyz.openbmc_project.Control.Power.RestorePolicy.Policy.Restore",
+       RestorePolicy::RESTORE}}},
+    RestorePolicy::UNKNOWN};
+} // namespace types
+} // namespace panel
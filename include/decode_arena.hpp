@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+
+namespace panel
+{
+/** @class DecodeArena
+ * @brief Arena to decode a D-Bus message into the types::pmr types.
+ *
+ * While the arena is alive it is the default memory resource, so containers
+ * of the types::pmr types, including those sdbusplus creates while decoding,
+ * are allocated from it. Allocations come from a buffer on the stack, and
+ * from the heap once it is used up. All of it is released at once when the
+ * arena goes out of scope, so it is meant to be created per message in the
+ * signal callback, and the decoded data must not outlive it.
+ *
+ * The default memory resource is process wide, so an arena must only be used
+ * on the event loop and must not be alive across a co_await.
+ */
+class DecodeArena
+{
+  public:
+    /* Deleted Api's*/
+    DecodeArena(const DecodeArena&) = delete;
+    DecodeArena& operator=(const DecodeArena&) = delete;
+    DecodeArena(DecodeArena&&) = delete;
+
+    /* Constructor */
+    DecodeArena() : previous(std::pmr::set_default_resource(&resource))
+    {
+    }
+
+    /* Destructor */
+    ~DecodeArena()
+    {
+        std::pmr::set_default_resource(previous);
+    }
+
+    /* Size of the buffer, enough for the usual signal. */
+    static constexpr size_t bufferSize = 4096;
+
+  private:
+    /* Buffer allocated from first. */
+    std::array<std::byte, bufferSize> buffer;
+
+    /* Resource allocating from the buffer, and from the heap once used up. */
+    std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size()};
+
+    /* Default memory resource before the arena. */
+    std::pmr::memory_resource* previous;
+};
+} // namespace panel
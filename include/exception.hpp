@@ -59,4 +59,27 @@ class FunctionFailure : public BaseException
     {
     }
 };
+
+class ExecutionCancelled : public BaseException
+{
+  public:
+    // deleted constructors
+    ExecutionCancelled() = delete;
+    ExecutionCancelled(const ExecutionCancelled&) = delete;
+    ExecutionCancelled(ExecutionCancelled&&) = delete;
+
+    // delete overloading operators
+    ExecutionCancelled& operator=(const ExecutionCancelled&) = delete;
+    ExecutionCancelled& operator=(const ExecutionCancelled&&) = delete;
+
+    // default destructor
+    ~ExecutionCancelled() = default;
+
+    /** @brief Constructor
+     * @param[in] msg - Error message.
+     */
+    explicit ExecutionCancelled(const std::string& msg) : BaseException(msg)
+    {
+    }
+};
 } // namespace panel
@@ -1,10 +1,22 @@
 #pragma once
 
+#include "pldm_fw.hpp"
+#include "progress_code_decoder.hpp"
 #include "transport.hpp"
 #include "types.hpp"
+#include "utils.hpp"
+#include "worker_pool.hpp"
 
+#include <array>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
 #include <deque>
+#include <functional>
+#include <map>
 #include <memory>
+#include <optional>
+#include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/message/native_types.hpp>
 
 namespace panel
@@ -26,8 +38,25 @@ class Executor
     /**
      * @brief Constructor
      * @param[in] transport - Pointer to transport class.
+     * @param[in] conn - D-Bus connection, for the functions that read D-Bus
+     * without blocking. Such functions fail when it is not given.
+     * @param[in] pldm - Pointer to PLDM framework, to send the functions owned
+     * by PHYP. Such functions fail when it is not given.
+     * @param[in] workers - Pointer to worker pool, to run the blocking D-Bus
+     * calls of functions. Calls are made on the event loop when not given.
+     * @param[in] hostControlConn - D-Bus connection of the host control
+     * functions alone. conn is used when not given.
      */
-    Executor(std::shared_ptr<Transport> transport) : transport(transport)
+    Executor(
+        std::shared_ptr<Transport> transport,
+        std::shared_ptr<sdbusplus::asio::connection> conn = nullptr,
+        std::shared_ptr<PldmFramework> pldm = nullptr,
+        std::shared_ptr<WorkerPool> workers = nullptr,
+        std::shared_ptr<sdbusplus::asio::connection> hostControlConn =
+            nullptr) :
+        transport(transport),
+        conn(conn), pldm(pldm), workers(workers),
+        hostControlConn(hostControlConn ? hostControlConn : conn)
     {
     }
 
@@ -45,6 +74,59 @@ class Executor
     void executeFunction(const types::FunctionNumber funcNumber,
                          const types::FunctionalityList& subFuncNumber);
 
+    /**
+     * @brief An api to cancel the function being executed.
+     *
+     * Called when the user moves away from the function. A function waiting on
+     * D-Bus stops at its next step and does not update the display.
+     */
+    void cancelExecution();
+
+    /**
+     * @brief An api to check if a function has data that can be prefetched.
+     * @param[in] funcNumber - function number.
+     * @return true if prefetchable, false otherwise.
+     */
+    static bool isPrefetchable(const types::FunctionNumber funcNumber);
+
+    /**
+     * @brief An api to check if a function takes effect on the system.
+     * Such a function is executed at most once per confirmationWindow.
+     * @param[in] funcNumber - function number.
+     * @param[in] subFuncNumber - sub function number list.
+     * @return true if destructive, false otherwise.
+     */
+    static bool isDestructive(const types::FunctionNumber funcNumber,
+                              const types::FunctionalityList& subFuncNumber);
+
+    /**
+     * @brief An api to prefetch the data of a function.
+     *
+     * Called when the user moves to a function, so that the data is likely
+     * ready by the time the function is executed. Prefetched data is used for
+     * prefetchTtl, and is ignored for functions that are not prefetchable.
+     *
+     * @param[in] funcNumber - function number.
+     */
+    void prefetch(const types::FunctionNumber funcNumber);
+
+    /**
+     * @brief An api to drop the cached display of a function.
+     * Called when the data shown by the function changes, so that it is
+     * fetched again on the next execution.
+     * @param[in] funcNumber - function number.
+     */
+    void invalidateDisplay(const types::FunctionNumber funcNumber);
+
+    /**
+     * @brief An api to load the display of function 20.
+     *
+     * Serial number, machine type and model do not change at runtime, so the
+     * display is loaded once and function 20 is executed without any D-Bus
+     * call. It is loaded again when the VPD of system or motherboard changes.
+     */
+    void loadVpdDisplay();
+
     /**
      * @brief Api to store callout list of last PEL.
      * @param[in] callOuts - list of callouts.
@@ -75,9 +157,9 @@ class Executor
 
     /**
      * @brief An api to store last 25 IPL SRCs.
-     * @param[in] progressCode - The progress code to store.
+     * @param[in] progressCode - The decoded progress code to store.
      */
-    void storeIPLSRC(const std::string& progressCode);
+    void storeIPLSRC(const decoder::ProgressCode& progressCode);
 
     /**
      * @brief An api to get count of IPL SRCs.
@@ -87,19 +169,82 @@ class Executor
      */
     inline uint8_t getIPLSRCCount() const
     {
-        return iplSrcs.size();
+        return iplSrcCount;
     }
 
   private:
+    /* Display lines reference
+    pair{line 1, line 2}
+    */
+    using Display = std::pair<std::string, std::string>;
+
+    /* Display key reference
+    pair{function number, sub function number}
+    */
+    using DisplayKey = std::pair<types::FunctionNumber, types::FunctionNumber>;
+
+    /**
+     * @brief Blocking calls of a function, waiting to be made.
+     */
+    struct Command
+    {
+        types::FunctionNumber funcNumber;
+        WorkerPool::Work calls;
+        std::function<void()> onSuccess;
+        std::chrono::steady_clock::time_point queuedAt;
+    };
+
+    /**
+     * @brief Prefetched display of a function.
+     */
+    struct PrefetchEntry
+    {
+        Display display;
+        std::chrono::steady_clock::time_point fetchedAt;
+
+        /* Set while the fetch is in flight, cancelled once it completes. */
+        std::shared_ptr<boost::asio::steady_timer> ready;
+    };
+
+    /**
+     * @brief An api to fetch the display of functionality 20.
+     * @return Display lines.
+     */
+    boost::asio::awaitable<Display> fetch20();
+
+    /**
+     * @brief An api to fetch the display of functionality 01.
+     * @return Display lines.
+     */
+    boost::asio::awaitable<Display> fetch01();
+
+    /**
+     * @brief An api to admit a function for execution.
+     *
+     * A press of a function being executed is dropped if the function only
+     * displays data, as the execution in flight displays it. Otherwise the
+     * press is rejected with a busy display, as is a press of a destructive
+     * function within its confirmation window.
+     *
+     * @param[in] funcNumber - function number.
+     * @param[in] subFuncNumber - sub function number list.
+     * @return true if the function is to be executed, false otherwise.
+     */
+    bool admitFunction(const types::FunctionNumber funcNumber,
+                       const types::FunctionalityList& subFuncNumber);
+
     /**
-     * @brief An api to execute functionality 20
+     * @brief An api to mark a function as being executed, until its effects
+     * are complete.
+     * @param[in] funcNumber - function number.
      */
-    void execute20();
+    void startFunction(const types::FunctionNumber funcNumber);
 
     /**
-     * @brief An api to execute functionality 01.
+     * @brief An api to make the blocking calls of the next queued function.
+     * Calls of one function are made at a time, in the order queued.
      */
-    void execute01();
+    void dispatchCommands();
 
     /**
      * @brief An api to execute function 04.
@@ -108,8 +253,12 @@ class Executor
 
     /**
      * @brief An api to execute function 02.
+     * Settings are written even if the execution is cancelled, so that they
+     * are not left partially applied.
+     * @param[in] subFuncNumber - Sub function vector.
      */
-    void execute02(const types::FunctionalityList& subFuncNumber);
+    boost::asio::awaitable<void>
+        execute02(types::FunctionalityList subFuncNumber);
 
     /**
      * @brief An api to execute function 03.
@@ -159,6 +308,42 @@ class Executor
      */
     void execute73();
 
+    /**
+     * @brief An api to request a state transition of a host control function.
+     *
+     * Functions 03, 08 and 73 are operator emergency actions, so the property
+     * is written without blocking, on the host control connection. Calls and
+     * replies of the other functions, such as prefetches and inventory reads,
+     * are not queued ahead of it there. The function is in flight until the
+     * write is accepted or fails, and the time from execution to acceptance
+     * is measured.
+     *
+     * @param[in] funcNumber - function being executed.
+     * @param[in] requestedAt - Time at which the function was executed.
+     * @param[in] service - Name of the service.
+     * @param[in] object - Object path.
+     * @param[in] interface - Interface name.
+     * @param[in] property - Transition property to write.
+     * @param[in] transition - Requested transition.
+     * @param[in] onAccepted - To complete the function once accepted.
+     */
+    void requestTransition(
+        const types::FunctionNumber funcNumber,
+        const std::chrono::steady_clock::time_point& requestedAt,
+        const std::string& service, const std::string& object,
+        const std::string& interface, const std::string& property,
+        const std::string& transition, std::function<void()> onAccepted);
+
+    /**
+     * @brief An api to complete a call of a host control function.
+     * Failure is displayed if the call is not accepted.
+     * @param[in] funcNumber - function being executed.
+     * @param[in] ec - Error of the call.
+     * @return true if the call is accepted, false otherwise.
+     */
+    bool completePriorityCall(const types::FunctionNumber funcNumber,
+                              const boost::system::error_code& ec);
+
     /**
      * @brief Api to get PEL eventId.
      *
@@ -175,8 +360,70 @@ class Executor
      */
     bool isOSIPLTypeEnabled() const;
 
-    /** @brief API to execute function 30. */
-    void execute30(const types::FunctionalityList& subFuncNumber);
+    /**
+     * @brief API to fetch the display of function 30.
+     * @param[in] subFuncNumber - Sub function number.
+     * @return Display lines.
+     */
+    boost::asio::awaitable<Display>
+        fetch30(types::FunctionNumber subFuncNumber);
+
+    /**
+     * @brief An api to fetch the display of a function.
+     * @param[in] key - Function and sub function number.
+     * @return Display lines.
+     */
+    boost::asio::awaitable<Display> fetchDisplay(DisplayKey key);
+
+    /**
+     * @brief An api to get the display of a function.
+     * Prefetched display is used if fresh, display is fetched otherwise.
+     * @param[in] key - Function and sub function number.
+     * @return Display lines.
+     */
+    boost::asio::awaitable<Display> getDisplay(DisplayKey key);
+
+    /**
+     * @brief An api to prefetch the display of a function.
+     * @param[in] key - Function and sub function number.
+     */
+    void startPrefetch(const DisplayKey& key);
+
+    /**
+     * @brief An api to execute a function that displays data read from D-Bus.
+     * @param[in] funcNumber - function number.
+     * @param[in] subFuncNumber - sub function number.
+     * @param[in] execution - Execution of the function.
+     */
+    boost::asio::awaitable<void>
+        executeDisplay(const types::FunctionNumber funcNumber,
+                       const types::FunctionNumber subFuncNumber,
+                       uint64_t execution);
+
+    /**
+     * @brief An api to start executing a function that reads D-Bus without
+     * blocking. The function being executed, if any, is cancelled.
+     * @return Execution of the function.
+     */
+    uint64_t startExecution();
+
+    /**
+     * @brief An api to stop a function if its execution is cancelled.
+     * @param[in] execution - Execution of the function.
+     * @throw ExecutionCancelled if cancelled.
+     */
+    void checkCancelled(uint64_t execution) const;
+
+    /**
+     * @brief An api to run a function on the event loop.
+     * Failure is displayed if the function throws.
+     * @param[in] funcNumber - function number.
+     * @param[in] subFuncNumber - sub function number list.
+     * @param[in] function - Coroutine of the function.
+     */
+    void spawnFunction(const types::FunctionNumber funcNumber,
+                       const types::FunctionalityList& subFuncNumber,
+                       boost::asio::awaitable<void> function);
 
     /**
      * @brief To display the execution result (function success/failure
@@ -201,6 +448,50 @@ class Executor
      */
     void execute55(const types::FunctionalityList& subFuncNumber);
 
+    /**
+     * @brief An api to execute functions owned by PHYP.
+     *
+     * Functions 21, 22, 34, 41 and 65 to 70 are executed by PHYP. The function
+     * is queued to be sent to PHYP over PLDM and "in progress" is displayed
+     * right away. Execution status is displayed once PHYP responds, unless
+     * the operator has moved to another function meanwhile.
+     *
+     * @param[in] funcNumber - function to execute.
+     */
+    void executePhypFunction(const types::FunctionNumber funcNumber);
+
+    /**
+     * @brief An api to send the queued PHYP functions.
+     * Functions are sent in the order they were executed, while the number of
+     * functions in flight is below the limit.
+     */
+    void dispatchPhypFunctions();
+
+    /**
+     * @brief An api to complete a PHYP function.
+     * Execution status is displayed if the function is still the one the
+     * panel is executing.
+     * @param[in] funcNumber - function completed.
+     * @param[in] result - true if PHYP executed the function.
+     */
+    void completePhypFunction(const types::FunctionNumber funcNumber,
+                              const bool result);
+
+    /**
+     * @brief An api to make the blocking calls of a function.
+     *
+     * Calls are queued and made on the worker pool when available, and the
+     * function completes on the event loop once the calls are done. Failure
+     * is displayed if the calls throw.
+     *
+     * @param[in] funcNumber - function being executed.
+     * @param[in] calls - Blocking calls of the function.
+     * @param[in] onSuccess - To complete the function, on the event loop.
+     */
+    void executeBlocking(const types::FunctionNumber funcNumber,
+                         WorkerPool::Work calls,
+                         std::function<void()> onSuccess = nullptr);
+
     /**
      * @brief Api to initiate service processor dump.
      * This method triggers a service processor dump when function 43 is pressed
@@ -211,11 +502,78 @@ class Executor
     /*Transport class object*/
     std::shared_ptr<Transport> transport;
 
+    /* D-Bus connection */
+    std::shared_ptr<sdbusplus::asio::connection> conn;
+
+    /* Current execution, changes when an execution starts or is cancelled. */
+    uint64_t currentExecution = 0;
+
+    /* Time for which prefetched display is used. */
+    static constexpr auto prefetchTtl = std::chrono::seconds(5);
+
+    /* Prefetched displays. */
+    std::map<DisplayKey, PrefetchEntry> prefetched;
+
+    /* Changes when cached displays are dropped. */
+    uint64_t displaysInvalidated = 0;
+
+    /* Display of function 20, once loaded. */
+    std::optional<utils::DisplayFrame> vpdDisplay;
+
+    /* Latest load of the display of function 20. */
+    uint64_t vpdDisplayLoad = 0;
+
+    /* PLDM framework object */
+    std::shared_ptr<PldmFramework> pldm;
+
+    /* Worker pool for blocking calls */
+    std::shared_ptr<WorkerPool> workers;
+
+    /* D-Bus connection of the host control functions */
+    std::shared_ptr<sdbusplus::asio::connection> hostControlConn;
+
+    /* Functions being executed, with the execution they were started for. */
+    std::map<types::FunctionNumber, uint64_t> functionsInFlight;
+
+    /* Time after a destructive function for which it is not executed again. */
+    static constexpr auto confirmationWindow = std::chrono::seconds(30);
+
+    /* Last time each destructive function was executed. */
+    std::map<types::FunctionNumber, std::chrono::steady_clock::time_point>
+        destructiveExecutedAt;
+
+    /* Queue of functions waiting for their blocking calls to be made. */
+    std::deque<Command> commandQueue;
+
+    /* Whether the blocking calls of a function are being made. */
+    bool commandInFlight = false;
+
+    /* Max number of PHYP functions in flight. */
+    static constexpr size_t maxPhypFunctionsInFlight = 2;
+
+    /* Max number of PHYP functions waiting to be sent. */
+    static constexpr size_t maxPhypFunctionsQueued = 8;
+
+    /* Queue of PHYP functions waiting to be sent. */
+    std::deque<types::FunctionNumber> phypFunctionQueue;
+
+    /* Number of PHYP functions sent and waiting for response. */
+    size_t phypFunctionsInFlight = 0;
+
     /* List of resolution property added to callouts */
     std::vector<std::string> callOutList;
 
-    /* List of last 25 IPL SRCs. */
-    std::deque<std::string> iplSrcs;
+    /* Max number of IPL SRCs to be stored. */
+    static constexpr uint8_t maxIplSrcs = 25;
+
+    /* Circular buffer of last 25 IPL SRCs. */
+    std::array<decoder::ProgressCode, maxIplSrcs> iplSrcs;
+
+    /* Index of the oldest IPL SRC in the circular buffer. */
+    uint8_t iplSrcStart = 0;
+
+    /* Number of IPL SRCs stored in the circular buffer. */
+    uint8_t iplSrcCount = 0;
 
     /* Queue of last 25 PEL SRCs */
     std::deque<std::string> pelEventIdQueue;
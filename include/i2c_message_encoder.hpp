@@ -60,6 +60,17 @@ class MessageEncoder
      */
     Binary buttonControl(Byte buttonID, Byte buttonOperation);
 
+    /* Default scroll rate of the internal scroll command, in msec. */
+    static constexpr Byte defaultScrollRate = 10;
+
+    /* Scroll rate of the hex words of an IPL SRC, in msec per step. Half
+     * the default step, as the line of up to eight hex words is several
+     * panel widths long. */
+    static constexpr Byte srcScrollRate = 5;
+
+    /* Default characters scrolled at a time by the internal scroll command. */
+    static constexpr Byte defaultScrollCount = 1;
+
     /** @brief Internal Scroll command encode api
      * The Internal Scroll command is used to start/stop display scrolling and
      * to define scroll characteristics. The Internal Scroll command is used to
@@ -81,9 +92,33 @@ class MessageEncoder
      *2 left continuously at rate specified. 0x22 - Line 2 right the number of
      *characters specified. 0x23 - Line 2 left the number of characters
      *specified. Others - Stop scrolling.
+     * @param[in] scrollRate - scroll rate, used by the continuous types.
+     * @param[in] scrollCount - number of characters scrolled, used by the
+     *stepped types.
+     * @return Encoded data packet of internal scroll command.
+     */
+    Binary scroll(Byte scrollControl, Byte scrollRate = defaultScrollRate,
+                  Byte scrollCount = defaultScrollCount);
+
+    /** @brief Internal Scroll command encode api, of a scroll type.
+     * @param[in] scrollType - scroll control type.
+     * @param[in] scrollRate - scroll rate, used by the continuous types.
+     * @param[in] scrollCount - number of characters scrolled, used by the
+     * stepped types.
      * @return Encoded data packet of internal scroll command.
      */
-    Binary scroll(Byte scrollControl);
+    Binary scroll(ScrollType scrollType, Byte scrollRate = defaultScrollRate,
+                  Byte scrollCount = defaultScrollCount);
+
+    /** @brief Stop Scroll command encode api
+     * Internal Scroll command which stops the display scrolling, leaving the
+     * display data as is.
+     * @return Encoded data packet of internal scroll command.
+     */
+    Binary stopScroll();
+
+    /* Duration of the lamp test, in seconds. */
+    static constexpr Byte lampTestDuration = 240;
 
     /** @brief Lamp test command encode api
      * The Lamp Test command is used to perform a lamp test on all illumination
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <chrono>
+#include <memory>
+#include <sdbusplus/asio/object_server.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace panel
+{
+/** @class IplTimeline
+ * @brief Track the phases of IPL and their durations.
+ *
+ * Every progress code received during an IPL is timestamped and grouped into
+ * a phase by its SRC prefix (e.g. C1, C2, C7, CA). The time spent in each phase
+ * is kept for the current and the previous IPL, so that boot time regressions
+ * can be measured across firmware levels.
+ */
+class IplTimeline
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /* Phase durations reference
+    array{tuple{phase prefix, duration in milliseconds}}
+    */
+    using PhaseDurations = std::vector<std::tuple<std::string, uint64_t>>;
+
+    /* Deleted Api's*/
+    IplTimeline(const IplTimeline&) = delete;
+    IplTimeline& operator=(const IplTimeline&) = delete;
+    IplTimeline(IplTimeline&&) = delete;
+
+    /* Constructor */
+    IplTimeline() = default;
+
+    /* Destructor */
+    ~IplTimeline() = default;
+
+    /**
+     * @brief Api to record a progress code.
+     *
+     * A new IPL is started by the first progress code after the previous IPL
+     * has ended, or by a progress code going back to the first phase of the
+     * current IPL (re-IPL).
+     *
+     * @param[in] referenceCode - Reference code of the progress code.
+     * @param[in] timeStamp - Time at which the progress code was received.
+     */
+    void recordProgressCode(std::string_view referenceCode,
+                            Clock::time_point timeStamp = Clock::now());
+
+    /**
+     * @brief Api to mark the end of the current IPL.
+     * It is called when the host clears the progress code display.
+     * @param[in] timeStamp - Time at which the IPL ended.
+     */
+    void endIpl(Clock::time_point timeStamp = Clock::now());
+
+    /**
+     * @brief Api to get the phase durations of the current IPL.
+     * Last phase of an IPL still in progress is measured till now.
+     * @param[in] now - Current time.
+     * @return Phase durations, in the order the phases were entered.
+     */
+    PhaseDurations
+        getCurrentIplPhases(Clock::time_point now = Clock::now()) const;
+
+    /**
+     * @brief Api to get the phase durations of the previous IPL.
+     * @return Phase durations, in the order the phases were entered.
+     */
+    PhaseDurations getPreviousIplPhases() const;
+
+    /**
+     * @brief Api to check if an IPL is in progress.
+     * @return true if a progress code was received after the last IPL end.
+     */
+    inline bool isIplInProgress() const
+    {
+        return !currentIpl.phases.empty() && !currentIpl.complete;
+    }
+
+    /**
+     * @brief Api to register the timeline methods on D-Bus.
+     * @param[in] iface - Interface on which the methods are to be registered.
+     */
+    void registerMethods(
+        std::shared_ptr<sdbusplus::asio::dbus_interface>& iface);
+
+  private:
+    /* Length of the SRC prefix which identifies a phase. */
+    static constexpr size_t phasePrefixLength = 2;
+
+    /* Max number of phases tracked in an IPL. */
+    static constexpr size_t maxPhases = 32;
+
+    /**
+     * @brief A structure to store a phase of IPL.
+     */
+    struct Phase
+    {
+        // SRC prefix of the phase.
+        std::string prefix{};
+
+        // Time at which the first progress code of the phase was received.
+        Clock::time_point start{};
+
+        // Time at which the last progress code of the phase was received.
+        Clock::time_point lastCode{};
+
+        // Number of progress codes received in the phase.
+        uint32_t codeCount = 0;
+    };
+
+    /**
+     * @brief A structure to store an IPL.
+     */
+    struct Ipl
+    {
+        // List of phases, in the order the phases were entered.
+        std::vector<Phase> phases{};
+
+        // Time at which the IPL ended.
+        Clock::time_point end{};
+
+        // If the IPL has ended.
+        bool complete = false;
+    };
+
+    /**
+     * @brief Api to compute phase durations of an IPL.
+     * @param[in] ipl - IPL whose phase durations are required.
+     * @param[in] now - End time of last phase if the IPL has not ended.
+     * @return Phase durations.
+     */
+    static PhaseDurations getPhaseDurations(const Ipl& ipl,
+                                            Clock::time_point now);
+
+    /* IPL in progress or the last IPL if none is in progress. */
+    Ipl currentIpl;
+
+    /* IPL prior to current IPL. */
+    Ipl previousIpl;
+};
+} // namespace panel
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <array>
+#include <boost/asio/io_context.hpp>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/* Log statements below this level are compiled out. Set through the
+ * log-level meson option, defaults to info. */
+#ifndef PANEL_LOG_LEVEL
+#define PANEL_LOG_LEVEL 6
+#endif
+
+namespace panel
+{
+namespace log
+{
+/**
+ * @brief Log levels, same as the syslog priorities.
+ */
+enum class Level : uint8_t
+{
+    ERROR = 3,
+    WARNING = 4,
+    INFO = 6,
+    DEBUG = 7
+};
+
+/**
+ * @brief Log categories, one per component of the app.
+ */
+enum class Category : uint8_t
+{
+    APP,
+    TRANSPORT,
+    STATE,
+    EXECUTOR,
+    BUS,
+    PLDM,
+    COUNT
+};
+
+/* Level of the log statements compiled in. */
+constexpr Level compiledLevel = static_cast<Level>(PANEL_LOG_LEVEL);
+
+/**
+ * @brief A log entry.
+ */
+struct Entry
+{
+    Level level;
+    Category category;
+    std::string message;
+};
+
+/* Api to write a log entry out. */
+using Sink = std::function<void(const Entry&)>;
+
+/**
+ * @brief Api to get the name of a category.
+ * @param[in] category - Log category.
+ * @return Name of the category.
+ */
+std::string_view getCategoryName(Category category);
+
+/**
+ * @brief Api to convert a level name to level.
+ * @param[in] name - Level name, e.g. "debug".
+ * @return Level, empty if the name is not valid.
+ */
+std::optional<Level> toLevel(std::string_view name);
+
+/** @class Logger
+ * @brief A class to filter and write out the log entries.
+ *
+ * Entries are written to the journal, with the priority and category as
+ * journal fields. Once attached to the event loop, entries are batched and
+ * written out after the current event is handled, so that handlers are not
+ * slowed down by the journal writes. Errors are written out right away, along
+ * with the entries batched before them. Entries can be logged from the worker
+ * threads as well.
+ */
+class Logger
+{
+  public:
+    /* Deleted Api's*/
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+    Logger(Logger&&) = delete;
+
+    /**
+     * @brief Api to get the logger.
+     * @return Logger of the app.
+     */
+    static Logger& getInstance();
+
+    /**
+     * @brief Api to check if entries of a level are to be logged.
+     * @param[in] level - Log level.
+     * @param[in] category - Log category.
+     * @return true if enabled, false otherwise.
+     */
+    inline bool isEnabled(Level level, Category category) const
+    {
+        return level <= levels[static_cast<size_t>(category)];
+    }
+
+    /**
+     * @brief Api to set the log level of all the categories.
+     * @param[in] level - Log level.
+     */
+    void setLevel(Level level);
+
+    /**
+     * @brief Api to set the log level of a category.
+     * @param[in] category - Log category.
+     * @param[in] level - Log level.
+     */
+    void setLevel(Category category, Level level);
+
+    /**
+     * @brief Api to attach the logger to the event loop.
+     * Entries are batched once attached, and written right away otherwise.
+     * @param[in] io - io_context of the event loop, nullptr to detach.
+     */
+    void attach(const std::shared_ptr<boost::asio::io_context>& io);
+
+    /**
+     * @brief Api to set the sink of the log entries.
+     * @param[in] sink - Sink, nullptr for the journal.
+     */
+    void setSink(Sink sink);
+
+    /**
+     * @brief Api to log an entry.
+     * @param[in] level - Log level.
+     * @param[in] category - Log category.
+     * @param[in] message - Log message.
+     */
+    void write(Level level, Category category, std::string&& message);
+
+    /** @brief Api to write out the batched entries. */
+    void flush();
+
+  private:
+    /* Constructor */
+    Logger();
+
+    /* Destructor */
+    ~Logger();
+
+    /** @brief Api to write out the batched entries, with the mutex held. */
+    void flushPending();
+
+    /* Max number of entries batched. */
+    static constexpr size_t maxBatchSize = 32;
+
+    /* Log level per category. */
+    std::array<Level, static_cast<size_t>(Category::COUNT)> levels;
+
+    /* io_context of the event loop. */
+    std::weak_ptr<boost::asio::io_context> io;
+
+    /* Mutex guarding the entries and the sink. */
+    std::mutex mutex;
+
+    /* Entries waiting to be written. */
+    std::vector<Entry> pending;
+
+    /* If flush is scheduled on the event loop. */
+    bool flushScheduled = false;
+
+    /* Sink of the log entries. */
+    Sink sink;
+};
+
+/**
+ * @brief Api to log a message.
+ * Statements below the compiled level are compiled out, and the message is
+ * formatted only if the level is enabled.
+ * @param[in] category - Log category.
+ * @param[in] args - Parts of the message.
+ */
+template <Level level, typename... Args>
+inline void emit(Category category, Args&&... args)
+{
+    if constexpr (level <= compiledLevel)
+    {
+        auto& logger = Logger::getInstance();
+        if (logger.isEnabled(level, category))
+        {
+            std::ostringstream message;
+            (message << ... << std::forward<Args>(args));
+            logger.write(level, category, message.str());
+        }
+    }
+}
+
+template <typename... Args>
+inline void error(Category category, Args&&... args)
+{
+    emit<Level::ERROR>(category, std::forward<Args>(args)...);
+}
+
+template <typename... Args>
+inline void warning(Category category, Args&&... args)
+{
+    emit<Level::WARNING>(category, std::forward<Args>(args)...);
+}
+
+template <typename... Args>
+inline void info(Category category, Args&&... args)
+{
+    emit<Level::INFO>(category, std::forward<Args>(args)...);
+}
+
+template <typename... Args>
+inline void debug(Category category, Args&&... args)
+{
+    emit<Level::DEBUG>(category, std::forward<Args>(args)...);
+}
+} // namespace log
+} // namespace panel
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "timer_wheel.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <sdbusplus/asio/object_server.hpp>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace panel
+{
+/** @class LoopMonitor
+ * @brief Measure the lag of the event loop.
+ *
+ * A timer is run periodically on the timer wheel of the event loop, the delay
+ * between the tick it is due at and the handler being called is the time the
+ * loop was busy with other handlers. The lag is recorded in the metrics of the
+ * app.
+ *
+ * Handlers that are wrapped in a HandlerScope are timed, and the ones that
+ * take longer than slowHandlerThreshold are counted by their name, so that a
+ * lag can be attributed to the handler that caused it.
+ *
+ * When the service runs with WatchdogSec, the probe also pings the systemd
+ * watchdog. A blocked event loop stops the pings and systemd restarts the
+ * service.
+ */
+class LoopMonitor
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /* Slow handlers reference
+    map{handler name, tuple{count, max duration in microseconds}}
+    */
+    using SlowHandlers =
+        std::map<std::string, std::tuple<uint64_t, uint64_t>, std::less<>>;
+
+    /* Handlers taking longer than this are reported as slow. */
+    static constexpr auto slowHandlerThreshold = std::chrono::milliseconds(50);
+
+    /** @class HandlerScope
+     * @brief Time a handler of the event loop, for as long as it is alive.
+     */
+    class HandlerScope
+    {
+      public:
+        /* Deleted Api's*/
+        HandlerScope(const HandlerScope&) = delete;
+        HandlerScope& operator=(const HandlerScope&) = delete;
+        HandlerScope(HandlerScope&&) = delete;
+
+        /**
+         * @brief Constructor
+         * @param[in] name - Name of the handler, must be a literal.
+         */
+        explicit HandlerScope(std::string_view name) :
+            name(name), start(Clock::now())
+        {
+        }
+
+        /* Destructor */
+        ~HandlerScope()
+        {
+            recordHandler(name, Clock::now() - start);
+        }
+
+      private:
+        /* Name of the handler. */
+        std::string_view name;
+
+        /* Time at which the handler started. */
+        Clock::time_point start;
+    };
+
+    /* Deleted Api's*/
+    LoopMonitor(const LoopMonitor&) = delete;
+    LoopMonitor& operator=(const LoopMonitor&) = delete;
+    LoopMonitor(LoopMonitor&&) = delete;
+
+    /**
+     * @brief Constructor
+     * The interval is shortened to half the watchdog timeout, if the
+     * watchdog is enabled for the service.
+     * @param[in] io - io_context of the event loop.
+     * @param[in] interval - Interval between the probes.
+     */
+    LoopMonitor(std::shared_ptr<boost::asio::io_context>& io,
+                Clock::duration interval = std::chrono::seconds(1));
+
+    /* Destructor */
+    ~LoopMonitor() = default;
+
+    /** @brief Api to start the probes. */
+    void start();
+
+    /** @brief Api to stop the probes. */
+    void stop();
+
+    /**
+     * @brief Api to record the duration of a handler.
+     * @param[in] name - Name of the handler.
+     * @param[in] duration - Time taken by the handler.
+     */
+    static void recordHandler(std::string_view name,
+                              Clock::duration duration);
+
+    /**
+     * @brief Api to get the slow handlers.
+     * @return Slow handlers.
+     */
+    static const SlowHandlers& getSlowHandlers();
+
+    /**
+     * @brief Api to register the slow handlers on D-Bus.
+     * @param[in] iface - Interface on which methods are to be registered.
+     */
+    static void registerMethods(
+        std::shared_ptr<sdbusplus::asio::dbus_interface>& iface);
+
+  private:
+    /** @brief Api to schedule the next probe. */
+    void scheduleProbe();
+
+    /* Timer of the probe. */
+    TimerWheel::Timer timer;
+
+    /* Interval between the probes. */
+    Clock::duration interval;
+
+    /* If the systemd watchdog is to be pinged. */
+    bool watchdogEnabled = false;
+};
+} // namespace panel
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sdbusplus/asio/object_server.hpp>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace panel
+{
+namespace metrics
+{
+/* Histogram reference
+tuple{count per bucket, total count, sum of values, max value}
+*/
+using HistogramSnapshot =
+    std::tuple<std::vector<uint64_t>, uint64_t, uint64_t, uint64_t>;
+
+/** @class Counter
+ * @brief A monotonic counter.
+ */
+class Counter
+{
+  public:
+    inline void increment(uint64_t count = 1)
+    {
+        value.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    inline uint64_t get() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<uint64_t> value{0};
+};
+
+/** @class Gauge
+ * @brief A value that can go up and down.
+ */
+class Gauge
+{
+  public:
+    inline void set(int64_t newValue)
+    {
+        value.store(newValue, std::memory_order_relaxed);
+    }
+
+    inline void add(int64_t delta = 1)
+    {
+        value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    inline void sub(int64_t delta = 1)
+    {
+        value.fetch_sub(delta, std::memory_order_relaxed);
+    }
+
+    inline int64_t get() const
+    {
+        return value.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<int64_t> value{0};
+};
+
+/** @class Histogram
+ * @brief A histogram of durations, in microseconds, with fixed buckets.
+ */
+class Histogram
+{
+  public:
+    /* Upper bounds of the buckets in microseconds. Values above the last
+     * bound are counted in an extra bucket. */
+    static constexpr std::array<uint64_t, 12> bounds = {
+        50,    100,   250,   500,    1000,   2500,
+        5000,  10000, 25000, 100000, 500000, 1000000};
+
+    /**
+     * @brief Api to add a value to the histogram.
+     * @param[in] value - Value in microseconds.
+     */
+    void observe(uint64_t value);
+
+    /**
+     * @brief Api to add a duration to the histogram.
+     * @param[in] duration - Duration.
+     */
+    inline void observe(std::chrono::steady_clock::duration duration)
+    {
+        observe(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(duration)
+                .count()));
+    }
+
+    /**
+     * @brief Api to read the histogram.
+     * @return Histogram snapshot.
+     */
+    HistogramSnapshot getSnapshot() const;
+
+  private:
+    std::array<std::atomic<uint64_t>, bounds.size() + 1> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> max{0};
+};
+
+/** @class CallTimer
+ * @brief Adds the time it is alive for to a histogram.
+ */
+class CallTimer
+{
+  public:
+    /* Deleted Api's*/
+    CallTimer(const CallTimer&) = delete;
+    CallTimer& operator=(const CallTimer&) = delete;
+    CallTimer(CallTimer&&) = delete;
+
+    explicit CallTimer(Histogram& histogram) :
+        histogram(histogram), start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~CallTimer()
+    {
+        histogram.observe(std::chrono::steady_clock::now() - start);
+    }
+
+  private:
+    Histogram& histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+/** @class Metrics
+ * @brief Metrics of the panel app.
+ *
+ * Metrics are updated with relaxed atomics and can be updated and read from
+ * any thread. They are exposed on D-Bus on com.ibm.panel.Metrics interface.
+ */
+class Metrics
+{
+  public:
+    /* Deleted Api's*/
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+    Metrics(Metrics&&) = delete;
+
+    /**
+     * @brief Api to get the metrics of the app.
+     * @return Metrics.
+     */
+    static Metrics& getInstance();
+
+    /**
+     * @brief Api to get the D-Bus call latency histogram of a service.
+     * @param[in] service - D-Bus service name.
+     * @return Histogram of the service.
+     */
+    Histogram& getDbusCallLatency(std::string_view service);
+
+    /**
+     * @brief Api to get the counters.
+     * @return Map of counter name and value.
+     */
+    std::map<std::string, uint64_t> getCounters() const;
+
+    /**
+     * @brief Api to get the gauges.
+     * @return Map of gauge name and value.
+     */
+    std::map<std::string, int64_t> getGauges() const;
+
+    /**
+     * @brief Api to get the histograms.
+     * @return Map of histogram name and snapshot.
+     */
+    std::map<std::string, HistogramSnapshot> getHistograms() const;
+
+    /**
+     * @brief Api to register the metrics on D-Bus.
+     * @param[in] iface - Interface on which metrics are to be registered.
+     */
+    void registerMethods(
+        std::shared_ptr<sdbusplus::asio::dbus_interface>& iface);
+
+    /* Panel button presses. */
+    Counter buttonEvents;
+
+    /* Frames written to the panel. */
+    Counter framesWritten;
+
+    /* Frames not written as the panel is not ready. */
+    Counter framesSuppressed;
+
+    /* Failed writes to the panel. */
+    Counter i2cErrors;
+
+    /* Attempts to reopen a failed panel device. */
+    Counter transportRecoveryAttempts;
+
+    /* Panel devices reopened after a failure. */
+    Counter transportRecoveries;
+
+    /* Panel devices failed and waiting to be reopened. */
+    Gauge transportsDown;
+
+    /* PELs received. */
+    Counter pelsReceived;
+
+    /* Progress codes received. */
+    Counter progressCodesReceived;
+
+    /* Prefetches of function data started. */
+    Counter prefetches;
+
+    /* Executions that used prefetched data. */
+    Counter prefetchHits;
+
+    /* Executions that had to fetch the data. */
+    Counter prefetchMisses;
+
+    /* Duplicate presses of a function dropped as it is being executed. */
+    Counter functionsCoalesced;
+
+    /* Presses of a function rejected as busy. */
+    Counter functionsRejected;
+
+    /* Functions waiting for their blocking calls to be made. */
+    Gauge commandQueueDepth;
+
+    /* Time functions wait for their blocking calls to be made. */
+    Histogram commandWait;
+
+    /* Time from execution of a host control function to its acceptance. */
+    Histogram priorityDispatch;
+
+    /* Time from the panel found present to its first display. */
+    Histogram panelAttach;
+
+    /* Event loop lag of the last probe, in microseconds. */
+    Gauge lastLoopLag;
+
+    /* Event loop lag. */
+    Histogram loopLag;
+
+  private:
+    /* Constructor */
+    Metrics() = default;
+
+    /* Max number of services whose call latency is tracked separately. */
+    static constexpr size_t maxServices = 16;
+
+    /**
+     * @brief D-Bus call latency of a service.
+     */
+    struct ServiceLatency
+    {
+        std::string service;
+        Histogram latency;
+    };
+
+    /* Call latency of the services, first serviceCount are in use. */
+    std::array<ServiceLatency, maxServices> serviceLatency;
+
+    /* Number of services tracked. */
+    std::atomic<size_t> serviceCount{0};
+
+    /* Mutex to add a service. */
+    std::mutex serviceMutex;
+
+    /* Call latency of services beyond maxServices. */
+    Histogram otherServicesLatency;
+};
+
+/**
+ * @brief Api to get the metrics of the app.
+ * @return Metrics.
+ */
+inline Metrics& get()
+{
+    return Metrics::getInstance();
+}
+} // namespace metrics
+} // namespace panel
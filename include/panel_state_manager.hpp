@@ -1,9 +1,13 @@
 #pragma once
 
+#include "dbus_enums.hpp"
 #include "executor.hpp"
+#include "timer_wheel.hpp"
 #include "transport.hpp"
 #include "types.hpp"
 
+#include <boost/asio/io_context.hpp>
+#include <chrono>
 #include <memory>
 #include <tuple>
 
@@ -87,16 +91,33 @@ class PanelStateManager
         isPanelStateActive = isEnabled;
     }
 
+    /* Time without a button event before the panel returns to function 01.
+     */
+    static constexpr auto inactivityTimeout = std::chrono::minutes(10);
+
+    /* Time the debounce SRC waits for its function to be confirmed. */
+    static constexpr auto debounceWindow = std::chrono::seconds(30);
+
     /**
      * @brief Constructor.
      * @param[in] transport - transport object to call transport functions
      * @param[in] execute - pointer to executor class.
+     * @param[in] io - io context to run the panel timers on, nullptr to run
+     * the panel without them.
      */
-    PanelStateManager(std::shared_ptr<Transport> transport,
-                      std::shared_ptr<Executor> execute) :
+    PanelStateManager(
+        std::shared_ptr<Transport> transport, std::shared_ptr<Executor> execute,
+        const std::shared_ptr<boost::asio::io_context>& io = nullptr) :
         transport(transport),
         funcExecutor(execute)
     {
+        if (io)
+        {
+            inactivityTimer =
+                std::make_unique<TimerWheel::Timer>(*io, "panelInactivity");
+            debounceTimer =
+                std::make_unique<TimerWheel::Timer>(*io, "debounceWindow");
+        }
         initPanelState();
     }
 
@@ -104,25 +125,25 @@ class PanelStateManager
      * @brief Api to toggle bmc state bit in member variable "systemState".
      * @param[in] bmcState - Bmc state.
      */
-    void updateBMCState(const std::string& bmcState);
+    void updateBMCState(types::BMCState bmcState);
 
     /**
      * @brief Api to toggle power state bit in member variable "systemState".
      * @param[in] powerState - Power state.
      */
-    void updatePowerState(const std::string& powerState);
+    void updatePowerState(types::PowerState powerState);
 
     /**
      * @brief Api to toggle boot progress state bit.
      * @param[in] bootState - Boot progress state.
      */
-    void updateBootProgressState(const std::string& bootState);
+    void updateBootProgressState(types::BootProgress bootState);
 
     /**
      * @brief Api to set system operating mode.
      * @param[in] operatingMode - Current mode of system.
      */
-    void setSystemOperatingMode(const std::string& operatingMode);
+    void setSystemOperatingMode(types::OperatingMode operatingMode);
 
   private:
     /**
@@ -132,6 +153,12 @@ class PanelStateManager
      */
     void initPanelState();
 
+    /**
+     * @brief An Api to return the Op-Panel to function 01.
+     * Called when no button is pressed for the inactivity timeout.
+     */
+    void returnToFunction01();
+
     /**
      * @brief An Api to increment Op-Panel state.
      */
@@ -263,6 +290,12 @@ class PanelStateManager
      * 7th bit - Reserved.
      */
     types::Byte systemState = 0;
+
+    /* Timer of the return to function 01 on inactivity. */
+    std::unique_ptr<TimerWheel::Timer> inactivityTimer;
+
+    /* Timer of the confirmation of the debounce SRC. */
+    std::unique_ptr<TimerWheel::Timer> debounceTimer;
 }; // class PanelStateManager
 
 } // namespace manager
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "const.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace panel
+{
+namespace platform
+{
+/** @brief I2C device and inventory object of a panel. */
+struct PanelDevice
+{
+    /* Path of the i2c bus. */
+    std::string_view devPath;
+
+    /* Address of the panel on the bus. */
+    uint8_t devAddr;
+
+    /* Inventory object of the panel, empty if not in the inventory. */
+    std::string_view dbusObj;
+};
+
+/** @brief Panel data of a platform. */
+struct Platform
+{
+    /* IM keyword of the platform. */
+    std::string_view im;
+
+    /* LCD panel. */
+    PanelDevice lcd;
+
+    /* Base panel, if the platform has one. */
+    std::optional<PanelDevice> base;
+
+    /* Input device of the panel buttons. */
+    std::string_view inputDevPath;
+};
+
+/* Test system(tacoma), used when the IM is not of a supported platform. */
+inline constexpr Platform tacoma{
+    "",
+    {constants::tacomaLcdDevPath, constants::devAddr, ""},
+    std::nullopt,
+    constants::tacomaInputDevPath};
+
+#ifdef PANEL_PLATFORM_RAINIER
+inline constexpr std::array<Platform, 3> rainierPlatforms{
+    {{constants::rain2s2uIM,
+      {constants::rainLcdDevPath, constants::devAddr,
+       constants::rainLcdDbusObj},
+      PanelDevice{constants::baseDevPath, constants::devAddr,
+                  constants::rainBaseDbusObj},
+      constants::rainInputDevPath},
+     {constants::rain2s4uIM,
+      {constants::rainLcdDevPath, constants::devAddr,
+       constants::rainLcdDbusObj},
+      PanelDevice{constants::baseDevPath, constants::devAddr,
+                  constants::rainBaseDbusObj},
+      constants::rainInputDevPath},
+     {constants::rain1s4uIM,
+      {constants::rainLcdDevPath, constants::devAddr,
+       constants::rainLcdDbusObj},
+      PanelDevice{constants::baseDevPath, constants::devAddr,
+                  constants::rainBaseDbusObj},
+      constants::rainInputDevPath}}};
+#else
+inline constexpr std::array<Platform, 0> rainierPlatforms{};
+#endif
+
+#ifdef PANEL_PLATFORM_EVEREST
+inline constexpr std::array<Platform, 1> everestPlatforms{
+    {{constants::everestIM,
+      {constants::everLcdDevPath, constants::devAddr,
+       constants::everLcdDbusObj},
+      PanelDevice{constants::baseDevPath, constants::devAddr,
+                  constants::everBaseDbusObj},
+      constants::everInputDevPath}}};
+#else
+inline constexpr std::array<Platform, 0> everestPlatforms{};
+#endif
+
+/**
+ * @brief Join the tables of the platforms.
+ * @param[in] first - Table of the first platforms.
+ * @param[in] second - Table of the other platforms.
+ * @return Table of all the platforms.
+ */
+template <size_t N, size_t M>
+constexpr std::array<Platform, N + M>
+    join(const std::array<Platform, N>& first,
+         const std::array<Platform, M>& second)
+{
+    std::array<Platform, N + M> platforms{};
+    std::copy(first.begin(), first.end(), platforms.begin());
+    std::copy(second.begin(), second.end(), platforms.begin() + N);
+    return platforms;
+}
+
+/* Platforms supported by the image, selected by the meson option platforms.
+ * The tables of the platforms not selected are not built in. */
+inline constexpr auto platforms = join(rainierPlatforms, everestPlatforms);
+
+/**
+ * @brief Find the platform of an IM keyword.
+ * @param[in] im - IM keyword, as a hex string.
+ * @return The platform, tacoma if the IM is not of a supported platform.
+ */
+constexpr const Platform& findPlatform(std::string_view im)
+{
+    for (const auto& platform : platforms)
+    {
+        if (platform.im == im)
+        {
+            return platform;
+        }
+    }
+    return tacoma;
+}
+} // namespace platform
+} // namespace panel
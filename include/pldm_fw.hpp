@@ -1,13 +1,49 @@
+#pragma once
+
+#include "dbus_enums.hpp"
+#include "timer_wheel.hpp"
 #include "types.hpp"
 
+#include <libpldm/platform.h>
 #include <stdint.h>
 
+#include <array>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <tuple>
 #include <vector>
 
 namespace panel
 {
 using PdrList = std::vector<types::PldmPacket>;
 
+/**
+ * @brief Status of a request sent to PHYP.
+ */
+enum class PldmStatus
+{
+    SUCCESS,          // PHYP responded with success completion code.
+    COMPLETION_ERROR, // PHYP responded with error completion code.
+    TIMEOUT,          // PHYP did not respond in time.
+    TRANSPORT_ERROR,  // MCTP socket failed before PHYP responded.
+    REQUEST_ERROR     // Request could not be prepared or sent to PHYP.
+};
+
+/* Handler called with the status and completion code of a request. */
+using PldmResponseHandler =
+    std::function<void(PldmStatus status, types::Byte completionCode)>;
+
+/* Api to open the MCTP socket, returns the socket fd or -1 on failure. */
+using MctpSocketOpener = std::function<int()>;
+
 /**
  * @brief A class to implement Pldm related functionalities.
  */
@@ -22,8 +58,15 @@ class PldmFramework
 
     /**
      * @brief Construtor
+     * Registers the signals on which the cached PDR data is invalidated.
+     * @param[in] io - Boost asio io_context object pointer.
+     * @param[in] conn - Bus connection.
+     * @param[in] socketOpener - Api to open the MCTP socket. The socket to
+     * mctp-demux daemon is opened when not given.
      */
-    PldmFramework() = default;
+    PldmFramework(std::shared_ptr<boost::asio::io_context>& io,
+                  std::shared_ptr<sdbusplus::asio::connection> conn,
+                  MctpSocketOpener socketOpener = nullptr);
 
     /**
      * @brief Destructor
@@ -35,9 +78,41 @@ class PldmFramework
      * This api is used to send panel function number to phyp by fetching and
      * setting the corresponding effector.
      *
+     * The api returns right away. The PDR and the instance id are looked up
+     * without blocking the event loop, and the request is sent on the long
+     * lived MCTP socket. The handler is called once PHYP responds, or the
+     * request times out, or it could not be sent, or the socket fails. It is
+     * never called from within this api. Several requests can be in flight at
+     * once, responses are matched to them by instance id.
+     *
      * @param[in] funcNumber - Function number that needs to be sent to PHYP.
+     * @param[in] handler - Handler to be called on completion of request.
      */
-    void sendPanelFunctionToPhyp(const types::FunctionNumber& funcNumber);
+    void sendPanelFunctionToPhyp(const types::FunctionNumber& funcNumber,
+                                 PldmResponseHandler handler);
+
+    /**
+     * @brief Invalidate the cached PDR data.
+     * PDRs are looked up again on the next request to PHYP.
+     */
+    inline void invalidatePdrCache()
+    {
+        effecterCache.clear();
+        cacheGeneration++;
+    }
+
+    /**
+     * @brief Check if the host PDRs are republished on a boot progress change.
+     * Host sends its PDRs to pldmd as the hypervisor starts, so they change
+     * on entering or leaving OS running and on a host reset, but not on the
+     * other steps of the IPL.
+     *
+     * @param[in] from - Boot progress before the change.
+     * @param[in] to - Boot progress after the change.
+     * @return true if the cached PDR data is to be invalidated.
+     */
+    static bool isPdrRepublished(types::BootProgress from,
+                                 types::BootProgress to);
 
   private:
     // TODO: <https://github.com/ibm-openbmc/ibm-panel/issues/57>
@@ -50,44 +125,139 @@ class PldmFramework
     static constexpr auto frontPanelBoardEntityId = (uint16_t)32837;
     static constexpr auto stateIdToEnablePanelFunc = (uint16_t)32778;
 
+    /* Max number of composite effecters in a set effecter states request. */
+    static constexpr size_t maxCompositeEffecters = 8;
+
+    /* Max size of set effecter states request. */
+    static constexpr size_t maxSetEffecterReqSize =
+        sizeof(pldm_msg_hdr) + PLDM_SET_STATE_EFFECTER_STATES_REQ_BYTES;
+
+    /* Set effecter states request message */
+    using SetEffecterRequest = std::array<types::Byte, maxSetEffecterReqSize>;
+
+    /* Time to wait for PHYP to respond to a request. */
+    static constexpr auto responseTimeout = std::chrono::seconds(5);
+
+    /**
+     * @brief A request sent to PHYP and waiting for response.
+     */
+    struct PendingRequest
+    {
+        // Function number sent to PHYP.
+        types::FunctionNumber function = 0;
+
+        // Handler to be called on completion of request.
+        PldmResponseHandler handler;
+
+        // Timer to detect response timeout.
+        std::unique_ptr<TimerWheel::Timer> timer;
+
+        // Time at which the request was sent.
+        std::chrono::steady_clock::time_point sentAt;
+
+        // Sequence number of the request, as instance ids are reused.
+        uint64_t sequence = 0;
+    };
+
+    /**
+     * @brief Panel effecter data decoded from the PDR.
+     */
+    struct PanelEffecterInfo
+    {
+        // Effecter id of the panel effecter.
+        uint16_t effecterId = 0;
+
+        // Number of composite effecters of the effecter.
+        types::Byte effecterCount = 0;
+
+        // Position of the panel state set in the composite effecters.
+        types::Byte panelEffecterPos = 0;
+
+        // Set effecter states request with no change to all the composite
+        // effecters but the panel one. Instance id and function are filled in
+        // per request.
+        SetEffecterRequest requestTemplate{};
+
+        // Size of the request.
+        size_t requestSize = 0;
+
+        // Offset of the panel effecter state in the request.
+        size_t functionOffset = 0;
+    };
+
+    /* Key of the PDR cache: tuple{terminusId, entityId, stateSetId} */
+    using PdrCacheKey = std::tuple<uint8_t, uint16_t, uint16_t>;
+
+    /**
+     * @brief Prepare and send a request to PHYP.
+     * @param[in] funcNumber - Function number that needs to be sent to PHYP.
+     * @param[in] handler - Handler to be called on completion of request.
+     */
+    boost::asio::awaitable<void>
+        sendRequest(types::FunctionNumber funcNumber,
+                    PldmResponseHandler handler);
+
+    /**
+     * @brief Get the panel effecter data.
+     * The data is decoded from the PDR on the first call and is served from
+     * the cache till the cache is invalidated. Requests made while the PDR is
+     * being fetched wait for that fetch.
+     *
+     * @return Panel effecter data.
+     * @throw FunctionFailure if the PDR could not be fetched or decoded.
+     */
+    boost::asio::awaitable<PanelEffecterInfo> getPanelEffecterInfo();
+
     /**
      * @brief An api to prepare "set effecter" request packet.
-     * This api prepares the message packet that needs to be sent to the PHYP.
+     * This api prepares the message packet that needs to be sent to the PHYP,
+     * by filling the instance id and function in the request template.
      *
-     * @param[in] pdrs - Panel pdr data.
+     * @param[in] effecterInfo - Panel effecter data.
      * @param[in] instanceId - instance id which uniquely identifies the
      * requested message packet. This needs to be encoded in the message packet.
      * @param[in] function - function number that needs to be sent to PHYP.
      *
-     * @return Returns a Pldm packet.
+     * @return Returns the request, of effecterInfo.requestSize bytes.
      */
-    types::PldmPacket
-        prepareSetEffecterReq(const PdrList& pdrs, types::Byte instanceId,
+    static SetEffecterRequest
+        prepareSetEffecterReq(const PanelEffecterInfo& effecterInfo,
+                              types::Byte instanceId,
                               const types::FunctionNumber& function);
 
     /**
-     * @brief Fetch the Panel effecter state set from PDR.
-     * This api fetches host effecter id, effecter count and effecter position
-     * from the panel's PDR.
-     * @param[in] pdrs - Panel PDR data.
-     * @param[out] effecterId - effecter id retrieved from the PDR.
-     * @param[out] effecterCount - effecter count retrieved from the PDR.
-     * @param[out] panelEffecterPos - Position of panel effecter.
+     * @brief Parse the Panel effecter PDR.
+     * This api fetches host effecter id, effecter count and the position of
+     * the panel state set from the panel's PDR. Possible states of all the
+     * composite effecters are walked, as they are of variable length. Request
+     * template is built from the data.
+     *
+     * @param[in] pdr - Panel effecter PDR.
+     * @return Panel effecter data.
+     *
+     * @throw FunctionFailure if the PDR is malformed or has no panel state
+     * set.
      */
+    static PanelEffecterInfo
+        parsePanelEffecterPdr(const types::PldmPacket& pdr);
 
-    void fetchPanelEffecterStateSet(const PdrList& pdrs, uint16_t& effecterId,
-                                    types::Byte& effecterCount,
-                                    types::Byte& panelEffecterPos);
+    /**
+     * @brief Build the set effecter states request template.
+     * @param[in,out] effecterInfo - Panel effecter data.
+     */
+    static void buildSetEffecterReqTemplate(PanelEffecterInfo& effecterInfo);
 
     /**
      * @brief Get instance ID
      * This api returns the instance id by making a dbus call to GetInstanceId
      * api of Pldm. Instance id is to uniquely identify a message packet. This
-     * id is generated by pldm.
+     * id is generated by pldm. An id allocated for a request that was never
+     * sent is returned first.
      *
      * @return one byte instance id.
+     * @throw FunctionFailure if the call fails.
      */
-    types::Byte getInstanceID();
+    boost::asio::awaitable<types::Byte> getInstanceID();
 
     /**
      * @brief Find and retrieve the PDR.
@@ -102,8 +272,82 @@ class PldmFramework
      * (FindStateEffecterPDR/FindStateSensorPDR).
      *
      * @return PDR data.
+     * @throw FunctionFailure if the call fails.
      */
-    PdrList getPDR(const uint8_t& terminusId, const uint16_t& entityId,
-                   const uint16_t& stateSetId, const std::string& pdrMethod);
+    boost::asio::awaitable<PdrList> getPDR(uint8_t terminusId,
+                                           uint16_t entityId,
+                                           uint16_t stateSetId,
+                                           std::string pdrMethod);
+
+    /**
+     * @brief Open the MCTP socket and register it with the io_context.
+     * @throw FunctionFailure if the socket could not be opened.
+     */
+    void openMctpSocket();
+
+    /**
+     * @brief Close the MCTP socket.
+     * All the requests in flight are completed with transport error.
+     */
+    void closeMctpSocket();
+
+    /** @brief Wait asynchronously for a message on the MCTP socket. */
+    void waitForResponse();
+
+    /**
+     * @brief Read a message from the MCTP socket and complete the matching
+     * request if the message is a response to it.
+     */
+    void processResponse();
+
+    /**
+     * @brief Complete a request in flight.
+     * @param[in] instanceId - Instance id of the request.
+     * @param[in] status - Status of the request.
+     * @param[in] completionCode - Completion code returned by PHYP.
+     */
+    void completeRequest(types::Byte instanceId, PldmStatus status,
+                         types::Byte completionCode);
+
+    /* boost asio io_context object pointer*/
+    std::shared_ptr<boost::asio::io_context> io;
+
+    /* Api to open the MCTP socket */
+    MctpSocketOpener socketOpener;
+
+    /* Long lived MCTP socket */
+    std::unique_ptr<boost::asio::posix::stream_descriptor> mctpSocket;
+
+    /* Requests waiting for response, per instance id. */
+    std::map<types::Byte, PendingRequest> pendingRequests;
+
+    /* Instance ids allocated by pldm for requests that failed before being
+     * sent. No response ever releases them, so they are reused instead. */
+    std::vector<types::Byte> spareInstanceIds;
+
+    /* Sequence number of the last request sent. */
+    uint64_t lastSequence = 0;
+
+    /* D-Bus connection. */
+    std::shared_ptr<sdbusplus::asio::connection> conn;
+
+    /* Panel effecter data decoded from the PDRs, per PDR lookup key. */
+    std::map<PdrCacheKey, PanelEffecterInfo> effecterCache;
+
+    /* Changes when the cache is invalidated. */
+    uint64_t cacheGeneration = 0;
+
+    /* Cancelled when the PDR being fetched is in the cache, if being
+     * fetched. */
+    std::shared_ptr<boost::asio::steady_timer> pdrFetched;
+
+    /* Signal to invalidate the cache when pldmd restarts. */
+    std::unique_ptr<sdbusplus::bus::match::match> pldmOwnerMatch;
+
+    /* Signal to invalidate the cache when the host republishes its PDRs. */
+    std::unique_ptr<sdbusplus::bus::match::match> hostProgressMatch;
+
+    /* Last boot progress of the host. */
+    types::BootProgress hostProgress = types::BootProgress::UNKNOWN;
 };
 } // namespace panel
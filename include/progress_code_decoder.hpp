@@ -0,0 +1,91 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+namespace panel
+{
+namespace decoder
+{
+/** @class ProgressCode
+ * @brief Decoded form of a boot progress code.
+ *
+ * Holds the full SRC of a progress code in a fixed size buffer, so that it can
+ * be stored and displayed without any heap allocation. The first word is the
+ * ASCII reference code carried by the primary code, followed by the hex words
+ * carried by the secondary data, separated by a space.
+ * e.g. "C7004091 00000000 0A200000 ..."
+ */
+class ProgressCode
+{
+  public:
+    /** Length of a word (reference code or hex word) in the SRC. */
+    static constexpr size_t wordLength = 8;
+
+    /** Max number of hex words (hex word 2 to 9) in the SRC. */
+    static constexpr size_t maxHexWords = 8;
+
+    /** Max length of the full SRC, same as the length of a display line. */
+    static constexpr size_t maxSrcLength =
+        wordLength + maxHexWords * (wordLength + 1);
+
+    /**
+     * @brief Api to get the full SRC.
+     * @return Reference code followed by the hex words.
+     */
+    inline std::string_view fullSrc() const
+    {
+        return std::string_view(buffer.data(), length);
+    }
+
+    /**
+     * @brief Api to get the reference code of the SRC.
+     * @return ASCII reference code, e.g. "C7004091".
+     */
+    inline std::string_view referenceCode() const
+    {
+        return fullSrc().substr(0, wordLength);
+    }
+
+    /**
+     * @brief Api to get the hex words of the SRC.
+     * @return Hex words separated by a space. Empty if the progress code had
+     * no secondary data.
+     */
+    inline std::string_view hexWords() const
+    {
+        return fullSrc().substr(
+            std::min(length, static_cast<uint8_t>(wordLength + 1)));
+    }
+
+  private:
+    friend ProgressCode decodeProgressCode(uint64_t primaryCode,
+                                           const types::Binary& secondaryCode);
+
+    /* Full SRC text */
+    std::array<char, maxSrcLength> buffer{};
+
+    /* Number of valid characters in the buffer */
+    uint8_t length = 0;
+};
+
+/**
+ * @brief Decode a boot progress code.
+ *
+ * The primary code carries the 8 character ASCII reference code with the first
+ * character in its least significant byte. The secondary data carries the
+ * 8 byte SRC header followed by hex words 2 to 9, each a 4 byte big endian
+ * value. Hex words missing in the secondary data are not added to the SRC.
+ *
+ * @param[in] primaryCode - Primary code of the PostCode.
+ * @param[in] secondaryCode - Secondary data of the PostCode.
+ * @return Decoded progress code.
+ */
+ProgressCode decodeProgressCode(uint64_t primaryCode,
+                                const types::Binary& secondaryCode);
+
+} // namespace decoder
+} // namespace panel
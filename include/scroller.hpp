@@ -0,0 +1,158 @@
+#pragma once
+
+#include "timer_wheel.hpp"
+#include "transport.hpp"
+#include "types.hpp"
+
+#include <array>
+#include <boost/asio/io_context.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace panel
+{
+/** @class Scroller
+ * @brief Scroll lines too long for the panel, from the BMC.
+ *
+ * The panel scrolls lines of up to 80 characters by itself, longer lines are
+ * truncated by it. Those are scrolled here instead, by writing a display of
+ * the 16 characters of each line in view, every time the view moves. Each
+ * line scrolls on its own, at its own speed, and pauses at its start and end.
+ * A single timer of the timer wheel is run for the next step of either line,
+ * and a display is written only if it differs from the last one.
+ */
+class Scroller
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /* Characters of a line in view on the panel. */
+    static constexpr size_t displayWidth = 16;
+
+    /* Max characters of a line the panel can scroll by itself. */
+    static constexpr size_t maxPanelLength = 80;
+
+    /** @brief Scroll characteristics of a line. */
+    struct Settings
+    {
+        /* Time between moves of the view by a character, rounded up to the
+         * tick of the timer wheel. */
+        std::chrono::milliseconds stepInterval{300};
+
+        /* Time the view stays at the start and end of the line. */
+        std::chrono::milliseconds endPause{1000};
+    };
+
+    /* Deleted Api's*/
+    Scroller(const Scroller&) = delete;
+    Scroller& operator=(const Scroller&) = delete;
+    Scroller(Scroller&&) = delete;
+
+    /**
+     * @brief Constructor
+     * @param[in] io - io_context of the event loop.
+     * @param[in] transport - Transport of the panel to scroll on.
+     */
+    Scroller(std::shared_ptr<boost::asio::io_context>& io,
+             std::shared_ptr<Transport> transport);
+
+    /* Destructor */
+    ~Scroller() = default;
+
+    /**
+     * @brief Check if the lines have to be scrolled from the BMC.
+     * @param[in] line1 - Line 1 data.
+     * @param[in] line2 - Line 2 data.
+     * @return true if a line is too long for the panel to scroll.
+     */
+    static inline bool isNeeded(const std::string& line1,
+                                const std::string& line2)
+    {
+        return line1.length() > maxPanelLength ||
+               line2.length() > maxPanelLength;
+    }
+
+    /**
+     * @brief Api to set the scroll characteristics of a line.
+     * Applies from the next display started.
+     * @param[in] line - 0 for line 1, 1 for line 2.
+     * @param[in] settings - Scroll characteristics.
+     */
+    void setSettings(size_t line, const Settings& settings);
+
+    /**
+     * @brief Api to start scrolling the lines, from their start.
+     * @param[in] line1 - Line 1 data.
+     * @param[in] line2 - Line 2 data.
+     */
+    void start(const std::string& line1, const std::string& line2);
+
+    /** @brief Api to stop scrolling, the display is left as is. */
+    void stop();
+
+    /**
+     * @brief Api to check if the lines are being scrolled.
+     * @return true if scrolling.
+     */
+    inline bool isScrolling() const
+    {
+        return scrolling;
+    }
+
+    /**
+     * @brief Api to get the characters of a line in view.
+     * @param[in] line - 0 for line 1, 1 for line 2.
+     * @return Characters in view.
+     */
+    std::string getView(size_t line) const;
+
+  private:
+    /** @brief A line being scrolled. */
+    struct Line
+    {
+        std::string text;
+        Settings settings;
+
+        /* Position of the first character in view. */
+        size_t offset = 0;
+
+        /* Time of the next move of the view. */
+        Clock::time_point nextStep;
+
+        /* If the line is longer than the view. */
+        inline bool isScrolled() const
+        {
+            return text.length() > displayWidth;
+        }
+    };
+
+    /**
+     * @brief Move the view of a line, if it is time to.
+     * @param[in] line - Line to move.
+     * @param[in] now - Current time.
+     */
+    void step(Line& line, Clock::time_point now);
+
+    /** @brief Write the lines in view, if different from the last display. */
+    void render();
+
+    /** @brief Run the timer for the next step of either line. */
+    void schedule();
+
+    /* Timer of the steps. */
+    TimerWheel::Timer timer;
+
+    /* Transport of the panel. */
+    std::shared_ptr<Transport> transport;
+
+    /* Lines being scrolled. */
+    std::array<Line, 2> lines;
+
+    /* Last display written. */
+    types::Binary lastFrame;
+
+    /* If the lines are being scrolled. */
+    bool scrolling = false;
+};
+} // namespace panel
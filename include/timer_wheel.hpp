@@ -0,0 +1,237 @@
+#pragma once
+
+#include <array>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <sdbusplus/asio/object_server.hpp>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace panel
+{
+/** @class TimerWheel
+ * @brief Hierarchical timer wheel of the panel timers.
+ *
+ * Panel timers are kept in the slots of a wheel of ticks, one wheel per level.
+ * Each level has 64 slots of 64 times the ticks of the level below, timers
+ * due in a later round of a level are kept in the level above and moved down
+ * as their slot comes round. Scheduling and cancelling a timer is O(1).
+ *
+ * A single steady_timer is run on the io_context for the next slot that has
+ * timers, so only one kernel timer is armed for all the panel timers.
+ *
+ * The wheel is a service of the io_context, created with the first timer.
+ */
+class TimerWheel : public boost::asio::execution_context::service
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void()>;
+
+    /* Pending timers reference
+    vector{tuple{timer name, milliseconds to expiry}}
+    */
+    using PendingTimers = std::vector<std::tuple<std::string, uint64_t>>;
+
+    /* Resolution of the timers. */
+    static constexpr auto tickDuration = std::chrono::milliseconds(10);
+
+    /* Id of the service. */
+    static inline boost::asio::execution_context::id id;
+
+  private:
+    /* Link of a timer in the list of its slot. */
+    struct Link
+    {
+        Link* prev = this;
+        Link* next = this;
+    };
+
+  public:
+    /** @class Timer
+     * @brief A timer on the wheel of its io_context.
+     * Cancelled when it goes out of scope.
+     */
+    class Timer : private Link
+    {
+      public:
+        /* Deleted Api's*/
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+        Timer(Timer&&) = delete;
+
+        /**
+         * @brief Constructor
+         * @param[in] io - io_context of the event loop.
+         * @param[in] name - Name of the timer, must be a literal.
+         */
+        Timer(boost::asio::io_context& io, std::string_view name);
+
+        /* Destructor */
+        ~Timer();
+
+        /**
+         * @brief Api to run a callback after a duration.
+         * A pending expiry of the timer is cancelled.
+         * @param[in] duration - Duration from now.
+         * @param[in] callback - Callback, run on the event loop.
+         */
+        void expiresAfter(Clock::duration duration, Callback callback);
+
+        /**
+         * @brief Api to run a callback at a time.
+         * A pending expiry of the timer is cancelled.
+         * @param[in] expiry - Time of expiry.
+         * @param[in] callback - Callback, run on the event loop.
+         */
+        void expiresAt(Clock::time_point expiry, Callback callback);
+
+        /** @brief Api to cancel the expiry, the callback is not run. */
+        void cancel();
+
+        /**
+         * @brief Api to get the time the timer is due.
+         * The expiry is rounded up to the tick of the wheel, the callback is
+         * run once the loop gets to it after this time.
+         * @return Time of the tick the timer expires, or expired, at.
+         */
+        Clock::time_point getExpiry() const;
+
+        /**
+         * @brief Api to check if the timer is pending.
+         * @return true if the timer is yet to expire.
+         */
+        inline bool isPending() const
+        {
+            return next != this;
+        }
+
+      private:
+        friend class TimerWheel;
+
+        /* Wheel of the timer, nullptr once the io_context is shut down. */
+        TimerWheel* wheel;
+
+        /* Name of the timer. */
+        std::string_view name;
+
+        /* Tick at which the timer expires. */
+        uint64_t expiryTick = 0;
+
+        /* Level of the wheel the timer is kept at. */
+        size_t level = 0;
+
+        /* Callback run at expiry. */
+        Callback callback;
+    };
+
+    /* Deleted Api's*/
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+    TimerWheel(TimerWheel&&) = delete;
+
+    /**
+     * @brief Constructor
+     * @param[in] context - io_context the wheel is a service of.
+     */
+    explicit TimerWheel(boost::asio::execution_context& context);
+
+    /* Destructor */
+    ~TimerWheel() = default;
+
+    /**
+     * @brief Api to get the pending timers, for debug.
+     * @return Pending timers, the earliest first.
+     */
+    PendingTimers getPendingTimers() const;
+
+    /** @brief Api to log the pending timers, for debug. */
+    void dump() const;
+
+    /**
+     * @brief Api to register the pending timers on D-Bus.
+     * @param[in] iface - Interface on which methods are to be registered.
+     */
+    void registerMethods(
+        std::shared_ptr<sdbusplus::asio::dbus_interface>& iface);
+
+  private:
+    /* Slots of a level, as bits of a tick. */
+    static constexpr size_t slotBits = 6;
+
+    /* Slots of a level. */
+    static constexpr size_t slotCount = size_t(1) << slotBits;
+
+    /* Levels of the wheel, 10ms ticks cover 46 hours. */
+    static constexpr size_t levelCount = 4;
+
+    /** @brief Cancel the timers on shutdown of the io_context. */
+    void shutdown() override;
+
+    /**
+     * @brief Get the tick of a time.
+     * @param[in] time - Time.
+     * @return Tick at or after the time.
+     */
+    uint64_t toTick(Clock::time_point time) const;
+
+    /**
+     * @brief Get the ticks elapsed till now.
+     * @return Ticks, rounded down.
+     */
+    uint64_t getElapsedTicks() const;
+
+    /**
+     * @brief Add a timer to the slot of its expiry.
+     * @param[in] timer - Timer to add.
+     */
+    void insert(Timer& timer);
+
+    /**
+     * @brief Remove a timer from its slot.
+     * @param[in] timer - Timer to remove.
+     */
+    void remove(Timer& timer);
+
+    /**
+     * @brief Get the next tick at which a slot with timers comes round.
+     * @return The tick, nullopt if there are no timers.
+     */
+    std::optional<uint64_t> getNextEventTick() const;
+
+    /**
+     * @brief Move the wheel up to a tick, expiring the timers on the way.
+     * @param[in] targetTick - Tick to move up to.
+     */
+    void advance(uint64_t targetTick);
+
+    /** @brief Arm the kernel timer for the next slot with timers. */
+    void arm();
+
+    /* Kernel timer. */
+    std::unique_ptr<boost::asio::steady_timer> kernelTimer;
+
+    /* Time of tick 0. */
+    Clock::time_point epoch;
+
+    /* Tick the wheel is at. */
+    uint64_t currentTick = 0;
+
+    /* Tick the kernel timer is armed for. */
+    std::optional<uint64_t> armedTick;
+
+    /* Slots of each level. */
+    std::array<std::array<Link, slotCount>, levelCount> slots;
+
+    /* Timers at each level. */
+    std::array<size_t, levelCount> levelSizes{};
+};
+} // namespace panel
@@ -1,15 +1,27 @@
 #pragma once
 
+#include "timer_wheel.hpp"
 #include "types.hpp"
 
 #include <unistd.h>
 
+#include <boost/asio/io_context.hpp>
+#include <chrono>
+#include <memory>
+#include <optional>
+
 namespace panel
 {
 /** @class Transport
  * @brief The Transport class is to communicate with the i2c devices.
  * When the BMC needs to communicate with the panel microcontroller, raw i2c
  * writes are made using transport class api.
+ *
+ * If the device can not be opened, or writes fail as the device is gone (for
+ * example after a bus reset), the device is closed and reopened with
+ * exponential backoff. Once reopened the panel is initialised again and the
+ * last display is written, so that the panel recovers without a restart of
+ * the app.
  */
 class Transport
 {
@@ -27,34 +39,81 @@ class Transport
     /**
      * A Constructor
      * Initialise the transport class object with the right panel device path
-     * and device address based on the system type.
+     * and device address based on the system type. If the device can not be
+     * opened, it is retried on the event loop.
+     * @param[in] io - io_context of the event loop.
+     * @param[in] devPath - Panel device path.
+     * @param[in] devAddr - Panel device address.
+     * @param[in] type - Panel type.
      */
-    Transport(const std::string& devPath, const uint8_t& devAddr,
-              const types::PanelType& type) :
-        devPath(devPath),
-        devAddress(devAddr), panelType(type)
-    {
-        panelI2CSetup();
-    }
+    Transport(std::shared_ptr<boost::asio::io_context>& io,
+              const std::string& devPath, const uint8_t& devAddr,
+              const types::PanelType& type);
 
     /**
      * A Destructor
      * Closes the valid file descriptor when the object goes out of scope.
      */
-    ~Transport()
+    ~Transport();
+
+    /* Delay before the first attempt to reopen a failed device. */
+    static constexpr auto minRecoveryDelay = std::chrono::milliseconds(100);
+
+    /* Max delay between the attempts to reopen a failed device. */
+    static constexpr auto maxRecoveryDelay = std::chrono::seconds(30);
+
+    /** @brief Backoff after a failed attempt to reopen the device.
+     * @param[in] delay - Delay before the failed attempt.
+     * @return Delay before the next attempt.
+     */
+    static std::chrono::milliseconds
+        nextRecoveryDelay(std::chrono::milliseconds delay);
+
+    /** @brief Method to get the delay before the next attempt to reopen the
+     * device.
+     * @return the delay, if an attempt is scheduled.
+     */
+    inline std::optional<std::chrono::milliseconds> getRecoveryDelay() const
     {
-        if (panelFileDescriptor != -1)
+        if (!recoveryPending)
         {
-            close(panelFileDescriptor);
+            return std::nullopt;
         }
+        return recoveryDelay;
     }
 
     /** @brief Write to the panel micro controller via I2C bus.
      * This api does raw i2c writes of the panel commands to the panel's micro
-     * controller.
+     * controller. The device is reopened if the write fails as it is gone.
      * @param[in] buffer - data that needs to be sent to the panel.
      */
-    void panelI2CWrite(const types::Binary& buffer) const;
+    void panelI2CWrite(const types::Binary& buffer);
+
+    /* Time the panel takes to do a soft reset. */
+    static constexpr auto softResetDelay = std::chrono::milliseconds(100);
+
+    /** @brief Attach the panel, once it is present.
+     * The panel is initialised without blocking the event loop, and the
+     * current display is written to it. Displays sent meanwhile are written
+     * once it is initialised.
+     * @param[in] presentAt - Time the panel was found present, the time to
+     * its first display is recorded in the metrics.
+     */
+    void attach(std::chrono::steady_clock::time_point presentAt);
+
+    /** @brief Detach the panel, once it is not present.
+     * Nothing is written to the panel till it is attached again, the current
+     * display is kept to be written then.
+     */
+    void detach();
+
+    /** @brief Method to check if the panel device is open.
+     * @return false if the device failed and is waiting to be reopened.
+     */
+    inline bool isHealthy() const
+    {
+        return panelFileDescriptor != -1;
+    }
 
     /** @brief Method to set the transport key
      * The transportKey boolean tells if the panel i2c bus is ready to use or
@@ -101,12 +160,56 @@ class Transport
      */
     void panelI2CSetup();
 
-    /** @brief API to do soft reset.
-     * The Panel Code Soft Reset command is used to perform a soft reset of
-     * the Panel micro-controller. This will re-initialize the Panel micro-code
-     * to its start-up values. A delay of 100milliseconds is added after the
-     * soft reset operation.
+    /** @brief Close the failed device and schedule it to be reopened. */
+    void markFailed();
+
+    /** @brief Schedule an attempt to reopen the device, after the backoff. */
+    void scheduleRecovery();
+
+    /** @brief Attempt to reopen the device.
+     * On success the panel is initialised again and the last display is
+     * written. On failure the backoff is doubled and it is retried.
      */
-    void doSoftReset();
+    void recover();
+
+    /** @brief Timer of the attempts to reopen the device. */
+    std::unique_ptr<TimerWheel::Timer> recoveryTimer;
+
+    /** @brief Delay before the next attempt to reopen the device. */
+    std::chrono::milliseconds recoveryDelay = minRecoveryDelay;
+
+    /** @brief If an attempt to reopen the device is scheduled. */
+    bool recoveryPending = false;
+
+    /** @brief Timer of the panel init. */
+    std::unique_ptr<TimerWheel::Timer> initTimer;
+
+    /** @brief If the panel is being initialised. */
+    bool attaching = false;
+
+    /** @brief Time the panel was found present, till its first display. */
+    std::optional<std::chrono::steady_clock::time_point> attachedAt;
+
+    /** @brief Write to the device, the device is reopened if it is gone.
+     * @param[in] buffer - data that needs to be sent to the panel.
+     * @return true if the data was written.
+     */
+    bool writeToDevice(const types::Binary& buffer);
+
+    /** @brief Write the last display and its scroll to the panel again. */
+    void replayDisplay();
+
+    /** @brief Initialise the panel without blocking the event loop.
+     * Soft reset is done and the buttons are configured after its delay,
+     * then the last display is written.
+     */
+    void initPanel();
+
+    /** @brief Last display written, to be written again on recovery or
+     * attach. */
+    types::Binary lastDisplay;
+
+    /** @brief Scroll of the last display, to be written again on recovery. */
+    types::Binary lastScroll;
 };
 } // namespace panel
@@ -2,9 +2,9 @@
 
 #include <iostream>
 #include <map>
+#include <memory_resource>
 #include <sdbusplus/server.hpp>
 #include <tuple>
-#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -19,11 +19,14 @@ using index = uint8_t;
 using FunctionalityList = std::vector<FunctionNumber>;
 using Byte = uint8_t;
 using Binary = std::vector<Byte>;
-using PanelDataTuple = std::tuple<std::string, uint8_t, std::string>;
-using PanelDataMap = std::unordered_map<std::string, PanelDataTuple>;
 using ItemInterfaceMap = std::map<std::string, std::variant<bool, std::string>>;
 using PldmPacket = std::vector<uint8_t>;
 
+/* PostCode reference
+tuple{primary code, secondary data}
+*/
+using PostCode = std::tuple<uint64_t, Binary>;
+
 /* DbusInterfaceMap reference
 map{InterfaceName, map{propertyName, value}}
 */
@@ -69,11 +72,62 @@ using GetManagedObjects = std::vector<std::pair<
                               int32_t, uint32_t, int64_t, uint64_t, double,
                               std::vector<std::string>>>>>>>;
 
+/* PropertyMap reference
+map{propertyName, value}, as returned by "GetAll"
+*/
+using PropertyMap = std::map<
+    std::string,
+    std::variant<bool, uint8_t, int16_t, uint16_t, int32_t, uint32_t, int64_t,
+                 uint64_t, double, std::string, std::vector<std::string>,
+                 Binary>>;
+
+/* ObjectInterface reference
+pair{object path, interface name}
+*/
+using ObjectInterface = std::pair<std::string, std::string>;
+
 using AttributeValueType = std::variant<int64_t, std::string>;
 using PendingAttributesItemType =
     std::pair<std::string, std::tuple<std::string, AttributeValueType>>;
 using PendingAttributesType = std::vector<PendingAttributesItemType>;
 
+/* Variants of the D-Bus decode types whose containers allocate from a
+ * memory resource, to decode a message in a DecodeArena. Strings are not pmr,
+ * as sdbusplus decodes D-Bus strings into std::string only.
+ */
+namespace pmr
+{
+using ItemInterfaceMap =
+    std::pmr::map<std::string, std::variant<bool, std::string>>;
+
+using DbusInterfaceMap = std::pmr::map<
+    std::string,
+    std::pmr::map<std::string,
+                  std::variant<bool, uint32_t, uint64_t, std::string,
+                               std::pmr::vector<std::string>,
+                               std::pmr::vector<std::tuple<
+                                   std::string, std::string, std::string>>>>>;
+
+using BiosBaseTableItem = std::pair<
+    std::string,
+    std::tuple<
+        std::string, bool, std::string, std::string, std::string,
+        std::variant<int64_t, std::string>, std::variant<int64_t, std::string>,
+        std::pmr::vector<
+            std::tuple<std::string, std::variant<int64_t, std::string>>>>>;
+using BiosBaseTable = std::pmr::vector<BiosBaseTableItem>;
+
+using GetManagedObjects = std::pmr::vector<std::pair<
+    sdbusplus::message::object_path,
+    std::pmr::vector<std::pair<
+        std::string,
+        std::pmr::map<std::string,
+                      std::variant<std::string, bool, uint8_t, int16_t,
+                                   uint16_t, int32_t, uint32_t, int64_t,
+                                   uint64_t, double,
+                                   std::pmr::vector<std::string>>>>>>>;
+} // namespace pmr
+
 enum ButtonEvent
 {
     INCREMENT,
@@ -87,11 +141,24 @@ enum PanelType
     LCD
 };
 
+/* Scroll control of the internal scroll command. Continuous modes scroll at
+ * the rate specified, stepped modes scroll the number of characters
+ * specified. */
 enum class ScrollType : Byte
 {
+    BOTH_RIGHT = 0x00,
     BOTH_LEFT = 0x01,
+    BOTH_RIGHT_STEP = 0x02,
+    BOTH_LEFT_STEP = 0x03,
+    LINE1_RIGHT = 0x10,
     LINE1_LEFT = 0x11,
+    LINE1_RIGHT_STEP = 0x12,
+    LINE1_LEFT_STEP = 0x13,
+    LINE2_RIGHT = 0x20,
     LINE2_LEFT = 0x21,
+    LINE2_RIGHT_STEP = 0x22,
+    LINE2_LEFT_STEP = 0x23,
+    STOP = 0xFF,
 };
 
 } // namespace types
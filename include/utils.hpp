@@ -1,7 +1,12 @@
 #pragma once
+#include <i2c_message_encoder.hpp>
+#include <logger.hpp>
+#include <metrics.hpp>
+#include <scroller.hpp>
 #include <sdbusplus/asio/object_server.hpp>
 #include <sstream>
 #include <string>
+#include <timer_wheel.hpp>
 #include <transport.hpp>
 #include <types.hpp>
 
@@ -29,12 +34,13 @@ T readBusProperty(const std::string& service, const std::string& object,
                                 "org.freedesktop.DBus.Properties", "Get");
         properties.append(inf);
         properties.append(prop);
+        metrics::CallTimer timer(metrics::get().getDbusCallLatency(service));
         auto result = bus.call(properties);
         result.read(retVal);
     }
     catch (const sdbusplus::exception::SdBusError& e)
     {
-        std::cerr << e.what();
+        log::error(log::Category::BUS, e.what());
     }
     return retVal;
 }
@@ -45,19 +51,61 @@ T readBusProperty(const std::string& service, const std::string& object,
  */
 std::string binaryToHexString(const types::Binary& val);
 
+/** @brief Set up the timed display behaviours of the panel.
+ * Lines too long for the panel are scrolled, and the display is restored at
+ * the end of a lamp test.
+ * @param[in] io - io context to run the timers on.
+ * @param[in] lineScroller - Scroller, nullptr to truncate such lines.
+ */
+void initDisplay(boost::asio::io_context& io,
+                 std::shared_ptr<Scroller> lineScroller);
+
 /** @brief Display on panel using transport class api.
  *
  * Method which sends the actual data to the panel's micro code using Transport
- * class write, to display the data on lcd panel.
- * TODO: Enable scroll if the lines exceeds 16 characters.
+ * class write, to display the data on lcd panel. Lines longer than 16
+ * characters are scrolled by the panel, lines longer than 80 characters by
+ * the scroller, if set.
  *
  * @param[in] line1 - line 1 data that needs to be displayed.
  * @param[in] line2 - line 2 data that needs to be displayed.
  * @param[in] transport - Transport class object to access panelI2CWrite
  * method.
+ * @param[in] scrollRate - rate at which the panel scrolls the lines.
  */
-void sendCurrDisplayToPanel(const std::string& line1, const std::string& line2,
-                            std::shared_ptr<Transport> transport);
+void sendCurrDisplayToPanel(
+    const std::string& line1, const std::string& line2,
+    std::shared_ptr<Transport> transport,
+    types::Byte scrollRate = encoder::MessageEncoder::defaultScrollRate);
+
+/**
+ * @brief Display lines along with their encoded frame.
+ * Built once for a display that rarely changes, so that only the write is
+ * left each time it is displayed.
+ */
+struct DisplayFrame
+{
+    std::string line1;
+    std::string line2;
+    types::Binary frame;
+};
+
+/** @brief Encode display lines into a frame.
+ * @param[in] line1 - line 1 data, not more than 16 characters.
+ * @param[in] line2 - line 2 data, not more than 16 characters.
+ * @return Display lines along with the encoded frame.
+ */
+DisplayFrame makeDisplayFrame(const std::string& line1,
+                              const std::string& line2);
+
+/** @brief Display an encoded frame on panel.
+ * Same as sendCurrDisplayToPanel, without encoding the lines again.
+ * @param[in] displayFrame - Display lines and their encoded frame.
+ * @param[in] transport - Transport class object to access panelI2CWrite
+ * method.
+ */
+void sendDisplayFrameToPanel(const DisplayFrame& displayFrame,
+                             std::shared_ptr<Transport> transport);
 
 /**
  * @brief An api to read System operating mode.
@@ -84,6 +132,29 @@ void readSystemOperatingMode(std::string& sysOperatingMode);
  */
 types::SystemParameterValues readSystemParameters();
 
+/**
+ * @brief An api to get System operating mode from its parameters.
+ * See readSystemOperatingMode for the values of the parameters.
+ * @param[in] quiesceOnHwError - QuiesceOnHwError property.
+ * @param[in] powerRestorePolicy - PowerRestorePolicy property.
+ * @param[in] autoReboot - AutoReboot property.
+ * @return Operating mode, empty if a property was not read.
+ */
+std::string
+    getSystemOperatingMode(const std::variant<bool>& quiesceOnHwError,
+                           const std::variant<std::string>& powerRestorePolicy,
+                           const std::variant<bool>& autoReboot);
+
+/**
+ * @brief An api to get the system parameters from BIOS base table.
+ * @param[in] biosTable - BaseBIOSTable property.
+ * @param[in] systemOperatingMode - System operating mode.
+ * @return - Values of required system parameters.
+ */
+types::SystemParameterValues getSystemParameters(
+    const std::variant<types::BiosBaseTable>& biosTable,
+    const std::string& systemOperatingMode);
+
 /** @brief Make d-bus call to "GetManagedObjects" method
  * @param[in] service - service on which the d-bus call needs to happen.
  * @param[in] object - object path.
@@ -116,11 +187,13 @@ void writeBusProperty(const std::string& serviceName,
         method.append(propertyName);
         method.append(paramValue);
 
+        metrics::CallTimer timer(
+            metrics::get().getDbusCallLatency(serviceName));
         bus.call(method);
     }
     catch (const sdbusplus::exception::SdBusError& e)
     {
-        std::cerr << e.what();
+        log::error(log::Category::BUS, e.what());
         throw;
     }
 }
@@ -137,8 +210,26 @@ std::vector<std::string> getBootSidePaths();
  */
 void getNextBootSide(std::string& nextBootSide);
 
+/**
+ * @brief Get the boot side path of the running image.
+ * @param[in] bootSidePaths - Boot side paths.
+ * @param[in] functional - Endpoints of the functional association.
+ * @return Path of the running image.
+ */
+std::string
+    findRunningImage(const std::vector<std::string>& bootSidePaths,
+                     const std::variant<std::vector<std::string>>& functional);
+
+/**
+ * @brief Get the boot side from priority of the running image.
+ * @param[in] priority - Priority property of the running image.
+ * @return "P" or "T", empty for other priorities.
+ */
+std::string getBootSide(const std::variant<uint8_t>& priority);
+
 /**
  * @brief Api which sends lamp test command to the panel.
+ * The display is restored once the lamp test duration has passed.
  * @param[in] transport - shared pointer object to transport class.
  */
 void doLampTest(std::shared_ptr<Transport>& transport);
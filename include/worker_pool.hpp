@@ -0,0 +1,128 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <exception>
+#include <functional>
+#include <memory>
+
+#ifdef PANEL_WORKER_THREADS
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace panel
+{
+/** @class WorkerPool
+ * @brief Run blocking calls off the event loop.
+ *
+ * Work submitted to the pool runs on one of the worker threads, and its
+ * completion is posted back to the event loop. Completions are run in the
+ * order the work was submitted, irrespective of the order in which the work
+ * finishes, so the state of the app is only ever touched from the event loop.
+ *
+ * Worker threads are used only when built with the worker-threads option.
+ * Otherwise the work is run on the event loop itself, as a posted handler.
+ */
+class WorkerPool
+{
+  public:
+    /* Blocking work. Exceptions thrown are passed to the completion. */
+    using Work = std::function<void()>;
+
+    /* Completion of the work, with the exception thrown by it, if any. */
+    using Completion = std::function<void(std::exception_ptr)>;
+
+    /* Deleted Api's*/
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+
+    /**
+     * @brief Constructor
+     * @param[in] io - io_context of the event loop.
+     * @param[in] threadCount - Number of worker threads.
+     */
+    WorkerPool(std::shared_ptr<boost::asio::io_context>& io,
+               size_t threadCount = 2);
+
+    /**
+     * @brief Destructor
+     * Waits for the work in progress, pending work is dropped.
+     */
+    ~WorkerPool();
+
+    /**
+     * @brief Api to submit a work to the pool.
+     * @param[in] work - Work to be run.
+     * @param[in] completion - Called on the event loop once work is done.
+     */
+    void submit(Work work, Completion completion);
+
+    /**
+     * @brief Api to check if the work runs on worker threads.
+     * @return true if worker threads are used, false otherwise.
+     */
+    static constexpr bool isThreaded()
+    {
+#ifdef PANEL_WORKER_THREADS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+  private:
+    /* io_context of the event loop. */
+    std::shared_ptr<boost::asio::io_context> io;
+
+#ifdef PANEL_WORKER_THREADS
+    /**
+     * @brief A work and its completion.
+     */
+    struct Job
+    {
+        uint64_t sequence;
+        Work work;
+        Completion completion;
+    };
+
+    /** @brief Api run by each worker thread. */
+    void runWorker();
+
+    /**
+     * @brief Api to post the completions of finished work, in order.
+     * Must be called with the mutex held.
+     */
+    void postCompletions();
+
+    /* Mutex guarding the members below. */
+    std::mutex mutex;
+
+    /* Signalled when a job is queued or the pool is stopped. */
+    std::condition_variable jobQueued;
+
+    /* Jobs waiting for a worker. */
+    std::deque<Job> jobs;
+
+    /* Finished jobs waiting for the jobs before them, by sequence. */
+    std::map<uint64_t, std::pair<Completion, std::exception_ptr>> finished;
+
+    /* Sequence of the next completion to be posted. */
+    uint64_t nextCompletion = 0;
+
+    /* If the pool is stopped. */
+    bool stopped = false;
+
+    /* Sequence of the next job. */
+    uint64_t nextSequence = 0;
+
+    /* Worker threads. */
+    std::vector<std::thread> workers;
+#endif
+};
+} // namespace panel
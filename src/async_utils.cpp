@@ -0,0 +1,161 @@
+#include "async_utils.hpp"
+
+#include "utils.hpp"
+
+namespace panel
+{
+namespace utils
+{
+boost::asio::awaitable<types::GetManagedObjects>
+    asyncGetManagedObjects(sdbusplus::asio::connection& conn,
+                           std::string service, std::string object)
+{
+    try
+    {
+        co_return co_await asyncMethodCall<types::GetManagedObjects>(
+            conn, std::move(service), std::move(object),
+            "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+    }
+    catch (const boost::system::system_error& e)
+    {
+        log::error(log::Category::BUS, e.what());
+    }
+    co_return types::GetManagedObjects{};
+}
+
+boost::asio::awaitable<std::vector<types::PropertyMap>>
+    asyncGetAllProperties(sdbusplus::asio::connection& conn,
+                          std::string service,
+                          std::vector<types::ObjectInterface> interfaces)
+{
+    metrics::CallTimer timer(metrics::get().getDbusCallLatency(service));
+
+    co_return co_await boost::asio::async_initiate<
+        const boost::asio::use_awaitable_t<>,
+        void(boost::system::error_code, std::vector<types::PropertyMap>)>(
+        [&](auto handler) {
+            using Handler = decltype(handler);
+            struct Batch
+            {
+                Handler handler;
+                std::vector<types::PropertyMap> properties;
+                size_t pending;
+            };
+            auto batch = std::make_shared<Batch>(
+                Batch{std::move(handler),
+                      std::vector<types::PropertyMap>(interfaces.size()),
+                      interfaces.size()});
+
+            if (interfaces.empty())
+            {
+                batch->handler(boost::system::error_code{},
+                               std::move(batch->properties));
+                return;
+            }
+
+            for (size_t index = 0; index < interfaces.size(); ++index)
+            {
+                conn.async_method_call(
+                    [batch, index](boost::system::error_code ec,
+                                   types::PropertyMap properties) {
+                        if (ec)
+                        {
+                            log::error(log::Category::BUS,
+                                       "GetAll failed: ", ec.message());
+                        }
+                        else
+                        {
+                            batch->properties[index] = std::move(properties);
+                        }
+
+                        if (--batch->pending == 0)
+                        {
+                            batch->handler(boost::system::error_code{},
+                                           std::move(batch->properties));
+                        }
+                    },
+                    service, interfaces[index].first,
+                    "org.freedesktop.DBus.Properties", "GetAll",
+                    interfaces[index].second);
+            }
+        },
+        boost::asio::use_awaitable);
+}
+
+boost::asio::awaitable<std::vector<std::string>>
+    asyncGetBootSidePaths(sdbusplus::asio::connection& conn)
+{
+    const int32_t depth = 0;
+    std::vector<std::string> intf{
+        "xyz.openbmc_project.Software.RedundancyPriority"};
+
+    co_return co_await asyncMethodCall<std::vector<std::string>>(
+        conn, "xyz.openbmc_project.ObjectMapper",
+        "/xyz/openbmc_project/object_mapper",
+        "xyz.openbmc_project.ObjectMapper", "GetSubTreePaths",
+        std::string("/xyz/openbmc_project/software"), depth, intf);
+}
+
+boost::asio::awaitable<std::string>
+    asyncGetNextBootSide(sdbusplus::asio::connection& conn)
+{
+    const auto bootSidePaths = co_await asyncGetBootSidePaths(conn);
+
+    // If we do not receive any path or just one path we default current
+    // boot side as "P".
+    if (bootSidePaths.size() != 2)
+    {
+        log::warning(log::Category::BUS,
+                     "Boot side path not equal to 2. Always mark selected side "
+                     "as P");
+        co_return std::string{};
+    }
+
+    // get functional framework list
+    const auto functionalFw =
+        co_await asyncReadBusProperty<std::variant<std::vector<std::string>>>(
+            conn, "xyz.openbmc_project.ObjectMapper",
+            "/xyz/openbmc_project/software/functional",
+            "xyz.openbmc_project.Association", "endpoints");
+
+    const auto runningImagePath = findRunningImage(bootSidePaths, functionalFw);
+
+    const auto priority = co_await asyncReadBusProperty<std::variant<uint8_t>>(
+        conn, "xyz.openbmc_project.Software.BMC.Updater", runningImagePath,
+        "xyz.openbmc_project.Software.RedundancyPriority", "Priority");
+
+    co_return getBootSide(priority);
+}
+
+boost::asio::awaitable<types::SystemParameterValues>
+    asyncReadSystemParameters(sdbusplus::asio::connection& conn)
+{
+    const auto biosTable =
+        co_await asyncReadBusProperty<std::variant<types::BiosBaseTable>>(
+            conn, "xyz.openbmc_project.BIOSConfigManager",
+            "/xyz/openbmc_project/bios_config/manager",
+            "xyz.openbmc_project.BIOSConfig.Manager", "BaseBIOSTable");
+
+    const auto logSettings = co_await asyncReadBusProperty<std::variant<bool>>(
+        conn, "xyz.openbmc_project.Settings",
+        "/xyz/openbmc_project/logging/settings",
+        "xyz.openbmc_project.Logging.Settings", "QuiesceOnHwError");
+
+    const auto restorePolicy =
+        co_await asyncReadBusProperty<std::variant<std::string>>(
+            conn, "xyz.openbmc_project.Settings",
+            "/xyz/openbmc_project/control/host0/power_restore_policy",
+            "xyz.openbmc_project.Control.Power.RestorePolicy",
+            "PowerRestorePolicy");
+
+    const auto rebootPolicy = co_await asyncReadBusProperty<std::variant<bool>>(
+        conn, "xyz.openbmc_project.Settings",
+        "/xyz/openbmc_project/control/host0/auto_reboot",
+        "xyz.openbmc_project.Control.Boot.RebootPolicy", "AutoReboot");
+
+    co_return getSystemParameters(
+        biosTable,
+        getSystemOperatingMode(logSettings, restorePolicy, rebootPolicy));
+}
+} // namespace utils
+} // namespace panel
@@ -1,6 +1,11 @@
 #include "bus_monitor.hpp"
 
 #include "const.hpp"
+#include "decode_arena.hpp"
+#include "logger.hpp"
+#include "loop_monitor.hpp"
+#include "metrics.hpp"
+#include "progress_code_decoder.hpp"
 #include "utils.hpp"
 
 #include <algorithm>
@@ -12,23 +17,35 @@ namespace panel
 
 void PanelPresence::readPresentProperty(sdbusplus::message::message& msg)
 {
+    const auto receivedAt = std::chrono::steady_clock::now();
+
     if (msg.is_method_error())
     {
-        std::cerr << "\n Error in reading panel presence signal " << std::endl;
+        log::error(log::Category::BUS,
+                   "Error in reading panel presence signal");
     }
     std::string object;
-    types::ItemInterfaceMap invItemMap;
+    DecodeArena arena;
+    types::pmr::ItemInterfaceMap invItemMap;
     msg.read(object, invItemMap);
     const auto itr = invItemMap.find("Present");
     if (itr != invItemMap.end())
     {
         if (auto present = std::get_if<bool>(&(itr->second)))
         {
-            transport->setTransportKey(*present);
+            if (*present)
+            {
+                transport->attach(receivedAt);
+            }
+            else
+            {
+                transport->detach();
+            }
         }
         else
         {
-            std::cerr << "\n Error reading panel present property" << std::endl;
+            log::error(log::Category::BUS,
+                       "Error reading panel present property");
         }
     }
 }
@@ -41,6 +58,7 @@ void PanelPresence::listenPanelPresence()
             sdbusplus::bus::match::rules::propertiesChanged(
                 objectPath, constants::itemInterface),
             [this](sdbusplus::message::message& msg) {
+                LoopMonitor::HandlerScope scope("readPresentProperty");
                 readPresentProperty(msg);
             });
 }
@@ -51,9 +69,11 @@ void PELListener::PELEventCallBack(sdbusplus::message::message& msg)
 
     sdbusplus::message::object_path objPath;
 
-    types::DbusInterfaceMap infMap;
+    DecodeArena arena;
+    types::pmr::DbusInterfaceMap infMap;
 
     msg.read(objPath, infMap);
+    metrics::get().pelsReceived.increment();
 
     const auto infItr = infMap.find("xyz.openbmc_project.Logging.Entry");
     if (infItr != infMap.end())
@@ -126,7 +146,8 @@ void PELListener::PELEventCallBack(sdbusplus::message::message& msg)
                     }
                     else
                     {
-                        std::cout << "No Callout found in the PEL";
+                        log::warning(log::Category::BUS,
+                                     "No Callout found in the PEL");
                     }
                 }
 
@@ -145,7 +166,7 @@ void PELListener::PELEventCallBack(sdbusplus::message::message& msg)
                         return;
                     }
                 }
-                std::cerr << "Event ID property not found" << std::endl;
+                log::error(log::Category::BUS, "Event ID property not found");
             }
         }
     }
@@ -157,7 +178,95 @@ void PELListener::listenPelEvents()
         *conn,
         sdbusplus::bus::match::rules::interfacesAdded(
             "/xyz/openbmc_project/logging"),
-        [this](sdbusplus::message::message& msg) { PELEventCallBack(msg); });
+        [this](sdbusplus::message::message& msg) {
+            LoopMonitor::HandlerScope scope("PELEventCallBack");
+            PELEventCallBack(msg);
+        });
+}
+
+void VpdListener::listenVpdChanges()
+{
+    static std::vector<std::unique_ptr<sdbusplus::bus::match::match>>
+        vpdMatches;
+
+    // VPD shown by function 20.
+    for (const auto& [object, interface] :
+         {std::make_pair(constants::systemInventoryObj, constants::assetIntf),
+          std::make_pair(constants::systemDbusObj, constants::assetIntf),
+          std::make_pair(constants::systemDbusObj, constants::vsysInterface)})
+    {
+        vpdMatches.push_back(std::make_unique<sdbusplus::bus::match::match>(
+            *conn,
+            sdbusplus::bus::match::rules::propertiesChanged(object, interface),
+            [this](sdbusplus::message::message&) {
+                LoopMonitor::HandlerScope scope("loadVpdDisplay");
+                executor->loadVpdDisplay();
+            }));
+    }
+
+    // objects are added once VPD is collected.
+    vpdMatches.push_back(std::make_unique<sdbusplus::bus::match::match>(
+        *conn,
+        sdbusplus::bus::match::rules::interfacesAdded(
+            "/xyz/openbmc_project/inventory"),
+        [this](sdbusplus::message::message& msg) {
+            LoopMonitor::HandlerScope scope("inventoryAddedCallBack");
+            inventoryAddedCallBack(msg);
+        }));
+}
+
+void VpdListener::inventoryAddedCallBack(sdbusplus::message::message& msg)
+{
+    // interfaces of the many objects added while VPD is collected are not
+    // needed, only the path is read.
+    sdbusplus::message::object_path objPath;
+    msg.read(objPath);
+
+    const std::string& path = objPath;
+    if (path == constants::systemInventoryObj ||
+        path == constants::systemDbusObj)
+    {
+        executor->loadVpdDisplay();
+    }
+}
+
+void SystemParameterListener::listenParameterChanges()
+{
+    static std::vector<std::unique_ptr<sdbusplus::bus::match::match>>
+        parameterMatches;
+
+    auto invalidate = [this](sdbusplus::message::message&) {
+        LoopMonitor::HandlerScope scope("invalidateDisplay");
+        executor->invalidateDisplay(1);
+    };
+
+    // parameters shown by function 01.
+    for (const auto& [object, interface] :
+         {std::make_pair("/xyz/openbmc_project/bios_config/manager",
+                         "xyz.openbmc_project.BIOSConfig.Manager"),
+          std::make_pair("/xyz/openbmc_project/logging/settings",
+                         "xyz.openbmc_project.Logging.Settings"),
+          std::make_pair(
+              "/xyz/openbmc_project/control/host0/power_restore_policy",
+              "xyz.openbmc_project.Control.Power.RestorePolicy"),
+          std::make_pair("/xyz/openbmc_project/control/host0/auto_reboot",
+                         "xyz.openbmc_project.Control.Boot.RebootPolicy")})
+    {
+        parameterMatches.push_back(
+            std::make_unique<sdbusplus::bus::match::match>(
+                *conn,
+                sdbusplus::bus::match::rules::propertiesChanged(object,
+                                                                interface),
+                invalidate));
+    }
+
+    // next boot side follows the priority of the images.
+    parameterMatches.push_back(std::make_unique<sdbusplus::bus::match::match>(
+        *conn,
+        sdbusplus::bus::match::rules::propertiesChangedNamespace(
+            "/xyz/openbmc_project/software",
+            "xyz.openbmc_project.Software.RedundancyPriority"),
+        invalidate));
 }
 
 void BootProgressCode::listenProgressCode()
@@ -169,54 +278,52 @@ void BootProgressCode::listenProgressCode()
             "/xyz/openbmc_project/state/boot/raw0",
             "xyz.openbmc_project.State.Boot.Raw"),
         [this](sdbusplus::message::message& msg) {
+            LoopMonitor::HandlerScope scope("progressCodeCallBack");
             progressCodeCallBack(msg);
         });
 }
 
 void BootProgressCode::progressCodeCallBack(sdbusplus::message::message& msg)
 {
-    using PostCode = std::tuple<uint64_t, std::vector<types::Byte>>;
-
     std::string interface{};
-    std::map<std::string, std::variant<PostCode>> propertyMap;
+    std::map<std::string, std::variant<types::PostCode>> propertyMap;
 
     msg.read(interface, propertyMap);
+    metrics::get().progressCodesReceived.increment();
 
     // property we are looking for.
     const auto it = propertyMap.find("Value");
     if (it != propertyMap.end())
     {
-        if (auto postCodeData = std::get_if<PostCode>(&(it->second)))
+        if (auto postCodeData = std::get_if<types::PostCode>(&(it->second)))
         {
-            auto src = std::get<0>(*postCodeData);
+            const auto& [primaryCode, secondaryCode] = *postCodeData;
 
             // clear display if progress code ascii equals to "00000000"
-            if (src == constants::clearDisplayProgressCode)
+            if (primaryCode == constants::clearDisplayProgressCode)
             {
                 utils::sendCurrDisplayToPanel(std::string{}, std::string{},
                                               transport);
+
+                // Host clears the display once it is done with the IPL.
+                iplTimeline->endIpl();
                 return;
             }
 
-            std::vector<types::Byte> byteArray;
-            byteArray.reserve(sizeof(src));
+            const auto progressCode =
+                decoder::decodeProgressCode(primaryCode, secondaryCode);
 
-            for (size_t i = 0; i < sizeof(src); i++)
-            {
-                byteArray.emplace_back(types::Byte(src >> (sizeof(src) * i)) &
-                                       0xFF);
-            }
+            iplTimeline->recordProgressCode(progressCode.referenceCode());
 
             utils::sendCurrDisplayToPanel(
-                std::string(byteArray.begin(), byteArray.end()), std::string{},
+                std::string{progressCode.referenceCode()}, std::string{},
                 transport);
 
-            executor->storeIPLSRC(
-                std::string(byteArray.begin(), byteArray.end()));
+            executor->storeIPLSRC(progressCode);
         }
         else
         {
-            std::cerr << "Progress code Data error" << std::endl;
+            log::error(log::Category::BUS, "Progress code Data error");
         }
     }
 }
@@ -237,7 +344,8 @@ SystemStatus::SystemStatus(
 void SystemStatus::bmcStateCallback(sdbusplus::message::message& msg)
 {
     std::string object{};
-    types::ItemInterfaceMap invItemMap;
+    DecodeArena arena;
+    types::pmr::ItemInterfaceMap invItemMap;
 
     msg.read(object, invItemMap);
     const auto itr = invItemMap.find("CurrentBMCState");
@@ -245,12 +353,13 @@ void SystemStatus::bmcStateCallback(sdbusplus::message::message& msg)
     {
         if (auto bmcState = std::get_if<std::string>(&(itr->second)))
         {
-            // std::cout << "BMC state = " << *bmcState << std::endl;
-            stateManager->updateBMCState(*bmcState);
+            log::debug(log::Category::BUS, "BMC state = ", *bmcState);
+            stateManager->updateBMCState(
+                types::bmcStateParser.parse(*bmcState));
         }
         else
         {
-            std::cerr << "\n Error reading bmc state property" << std::endl;
+            log::error(log::Category::BUS, "Error reading bmc state property");
         }
     }
 }
@@ -264,26 +373,30 @@ void SystemStatus::listenBmcState()
 
     if (auto curBmcState = std::get_if<std::string>(&retCurBmcState))
     {
-        stateManager->updateBMCState(*curBmcState);
+        stateManager->updateBMCState(
+            types::bmcStateParser.parse(*curBmcState));
     }
     else
     {
         // read failed for current bmc state so set it as "not ready".
-        stateManager->updateBMCState(
-            "xyz.openbmc_project.State.BMC.BMCState.NotReady");
+        stateManager->updateBMCState(types::BMCState::NOT_READY);
     }
 
     static auto sigBmcState = std::make_unique<sdbusplus::bus::match::match>(
         *conn,
         sdbusplus::bus::match::rules::propertiesChanged(
             "/xyz/openbmc_project/state/bmc0", "xyz.openbmc_project.State.BMC"),
-        [this](sdbusplus::message::message& msg) { bmcStateCallback(msg); });
+        [this](sdbusplus::message::message& msg) {
+            LoopMonitor::HandlerScope scope("bmcStateCallback");
+            bmcStateCallback(msg);
+        });
 }
 
 void SystemStatus::powerStateCallback(sdbusplus::message::message& msg)
 {
     std::string object{};
-    types::ItemInterfaceMap invItemMap;
+    DecodeArena arena;
+    types::pmr::ItemInterfaceMap invItemMap;
 
     msg.read(object, invItemMap);
     const auto itr = invItemMap.find("CurrentPowerState");
@@ -291,12 +404,14 @@ void SystemStatus::powerStateCallback(sdbusplus::message::message& msg)
     {
         if (auto powerState = std::get_if<std::string>(&(itr->second)))
         {
-            // std::cout << "Power state = " << *powerState << std::endl;
-            stateManager->updatePowerState(*powerState);
+            log::debug(log::Category::BUS, "Power state = ", *powerState);
+            stateManager->updatePowerState(
+                types::powerStateParser.parse(*powerState));
         }
         else
         {
-            std::cerr << "\n Error reading power state property" << std::endl;
+            log::error(log::Category::BUS,
+                       "Error reading power state property");
         }
     }
 }
@@ -311,13 +426,13 @@ void SystemStatus::listenPowerState()
 
     if (auto curPowerState = std::get_if<std::string>(&retCurPowerState))
     {
-        stateManager->updatePowerState(*curPowerState);
+        stateManager->updatePowerState(
+            types::powerStateParser.parse(*curPowerState));
     }
     else
     {
         // read failed for power state so set it as "Off".
-        stateManager->updatePowerState(
-            "xyz.openbmc_project.State.Chassis.PowerState.Off");
+        stateManager->updatePowerState(types::PowerState::OFF);
     }
 
     static auto sigPowerState = std::make_unique<sdbusplus::bus::match::match>(
@@ -325,13 +440,17 @@ void SystemStatus::listenPowerState()
         sdbusplus::bus::match::rules::propertiesChanged(
             "/xyz/openbmc_project/state/chassis0",
             "xyz.openbmc_project.State.Chassis"),
-        [this](sdbusplus::message::message& msg) { powerStateCallback(msg); });
+        [this](sdbusplus::message::message& msg) {
+            LoopMonitor::HandlerScope scope("powerStateCallback");
+            powerStateCallback(msg);
+        });
 }
 
 void SystemStatus::bootProgressStateCallback(sdbusplus::message::message& msg)
 {
     std::string object{};
-    types::ItemInterfaceMap invItemMap;
+    DecodeArena arena;
+    types::pmr::ItemInterfaceMap invItemMap;
 
     msg.read(object, invItemMap);
     const auto itr = invItemMap.find("BootProgress");
@@ -339,14 +458,15 @@ void SystemStatus::bootProgressStateCallback(sdbusplus::message::message& msg)
     {
         if (auto bootProgressState = std::get_if<std::string>(&(itr->second)))
         {
-            // std::cout << "boot progress state = " << *bootProgressState
-            //          << std::endl;
-            stateManager->updateBootProgressState(*bootProgressState);
+            log::debug(log::Category::BUS, "Boot progress state = ",
+                       *bootProgressState);
+            stateManager->updateBootProgressState(
+                types::bootProgressParser.parse(*bootProgressState));
         }
         else
         {
-            std::cerr << "\n Error reading boot progress state property"
-                      << std::endl;
+            log::error(log::Category::BUS,
+                       "Error reading boot progress state property");
         }
     }
 }
@@ -360,14 +480,14 @@ void SystemStatus::listenBootProgressState()
 
     if (auto curBootProgressState = std::get_if<std::string>(&retBootProgress))
     {
-        stateManager->updateBootProgressState(*curBootProgressState);
+        stateManager->updateBootProgressState(
+            types::bootProgressParser.parse(*curBootProgressState));
     }
     else
     {
         // read failed for boot progress state so set it as "Unspecified".
         stateManager->updateBootProgressState(
-            "xyz.openbmc_project.State.Boot.Progress."
-            "ProgressStages.Unspecified");
+            types::BootProgress::UNSPECIFIED);
     }
 
     static auto sigBootState = std::make_unique<sdbusplus::bus::match::match>(
@@ -376,6 +496,7 @@ void SystemStatus::listenBootProgressState()
             "/xyz/openbmc_project/state/host0",
             "xyz.openbmc_project.State.Boot.Progress"),
         [this](sdbusplus::message::message& msg) {
+            LoopMonitor::HandlerScope scope("bootProgressStateCallback");
             bootProgressStateCallback(msg);
         });
 }
@@ -383,7 +504,8 @@ void SystemStatus::listenBootProgressState()
 void SystemStatus::loggingSettingStateCallback(sdbusplus::message::message& msg)
 {
     std::string object{};
-    types::ItemInterfaceMap invItemMap;
+    DecodeArena arena;
+    types::pmr::ItemInterfaceMap invItemMap;
 
     msg.read(object, invItemMap);
     const auto itr = invItemMap.find("QuiesceOnHwError");
@@ -391,15 +513,16 @@ void SystemStatus::loggingSettingStateCallback(sdbusplus::message::message& msg)
     {
         if (auto loggingSetting = std::get_if<bool>(&(itr->second)))
         {
-            // std::cout << "loggingSettingState = " << *loggingSetting
-            //          << std::endl;
+            log::debug(log::Category::BUS, "Logging setting state = ",
+                       *loggingSetting);
             loggingPolicy = *loggingSetting;
 
             setSystemCurrentOperatingMode();
         }
         else
         {
-            std::cerr << "\n Error reading logging state property" << std::endl;
+            log::error(log::Category::BUS,
+                       "Error reading logging state property");
         }
     }
 }
@@ -407,7 +530,8 @@ void SystemStatus::loggingSettingStateCallback(sdbusplus::message::message& msg)
 void SystemStatus::powerPolicyStateCallback(sdbusplus::message::message& msg)
 {
     std::string object{};
-    types::ItemInterfaceMap invItemMap;
+    DecodeArena arena;
+    types::pmr::ItemInterfaceMap invItemMap;
 
     msg.read(object, invItemMap);
     const auto itr = invItemMap.find("PowerRestorePolicy");
@@ -415,14 +539,15 @@ void SystemStatus::powerPolicyStateCallback(sdbusplus::message::message& msg)
     {
         if (auto powerState = std::get_if<std::string>(&(itr->second)))
         {
-            // std::cout << "power state = " << *powerState << std::endl;
-            powerPolicy = *powerState;
+            log::debug(log::Category::BUS, "Power policy = ", *powerState);
+            powerPolicy = types::restorePolicyParser.parse(*powerState);
 
             setSystemCurrentOperatingMode();
         }
         else
         {
-            std::cerr << "Failed to read power policy from Dbus" << std::endl;
+            log::error(log::Category::BUS,
+                       "Failed to read power policy from Dbus");
         }
     }
 }
@@ -430,7 +555,8 @@ void SystemStatus::powerPolicyStateCallback(sdbusplus::message::message& msg)
 void SystemStatus::rebootPolicyStateCallback(sdbusplus::message::message& msg)
 {
     std::string object{};
-    types::ItemInterfaceMap invItemMap;
+    DecodeArena arena;
+    types::pmr::ItemInterfaceMap invItemMap;
 
     msg.read(object, invItemMap);
     const auto itr = invItemMap.find("AutoReboot");
@@ -438,14 +564,15 @@ void SystemStatus::rebootPolicyStateCallback(sdbusplus::message::message& msg)
     {
         if (auto rebootState = std::get_if<bool>(&(itr->second)))
         {
-            // std::cout << "reboot state = " << *rebootState << std::endl;
+            log::debug(log::Category::BUS, "Reboot policy = ", *rebootState);
             rebootPolicy = *rebootState;
 
             setSystemCurrentOperatingMode();
         }
         else
         {
-            std::cerr << "Failed to read reboot policy from Dbus" << std::endl;
+            log::error(log::Category::BUS,
+                       "Failed to read reboot policy from Dbus");
         }
     }
 }
@@ -459,6 +586,7 @@ void SystemStatus::listenSystemOperatingModeParameters()
                 "/xyz/openbmc_project/logging/settings",
                 "xyz.openbmc_project.Logging.Settings"),
             [this](sdbusplus::message::message& msg) {
+                LoopMonitor::HandlerScope scope("loggingSettingStateCallback");
                 loggingSettingStateCallback(msg);
             });
 
@@ -468,6 +596,7 @@ void SystemStatus::listenSystemOperatingModeParameters()
             "/xyz/openbmc_project/control/host0/power_restore_policy",
             "xyz.openbmc_project.Control.Power.RestorePolicy"),
         [this](sdbusplus::message::message& msg) {
+            LoopMonitor::HandlerScope scope("powerPolicyStateCallback");
             powerPolicyStateCallback(msg);
         });
 
@@ -478,6 +607,7 @@ void SystemStatus::listenSystemOperatingModeParameters()
                 "/xyz/openbmc_project/control/host0/auto_reboot",
                 "xyz.openbmc_project.Control.Boot.RebootPolicy"),
             [this](sdbusplus::message::message& msg) {
+                LoopMonitor::HandlerScope scope("rebootPolicyStateCallback");
                 rebootPolicyStateCallback(msg);
             });
 }
@@ -496,8 +626,8 @@ void SystemStatus::initSystemOperatingParameters()
     {
         // for error set the parameters for Normal mode value.
         loggingPolicy = false;
-        std::cerr << "Failed to read logging setting dbus property"
-                  << std::endl;
+        log::error(log::Category::BUS,
+                   "Failed to read logging setting dbus property");
     }
 
     auto retPowerSettings = utils::readBusProperty<std::variant<std::string>>(
@@ -508,14 +638,13 @@ void SystemStatus::initSystemOperatingParameters()
 
     if (auto powerSettings = std::get_if<std::string>(&retPowerSettings))
     {
-        powerPolicy = *powerSettings;
+        powerPolicy = types::restorePolicyParser.parse(*powerSettings);
     }
     else
     {
         // for error set the parameters for Normal mode value.
-        powerPolicy =
-            "xyz.openbmc_project.Control.Power.RestorePolicy.Policy.Restore";
-        std::cerr << "Failed to read power policy from Dbus" << std::endl;
+        powerPolicy = types::RestorePolicy::RESTORE;
+        log::error(log::Category::BUS, "Failed to read power policy from Dbus");
     }
 
     auto retRebootSetting = utils::readBusProperty<std::variant<bool>>(
@@ -531,7 +660,7 @@ void SystemStatus::initSystemOperatingParameters()
     {
         // for error set the parameters for Normal mode value.
         rebootPolicy = true;
-        std::cerr << "Failed t read reboot folicy form Dbus" << std::endl;
+        log::error(log::Category::BUS, "Failed t read reboot folicy form Dbus");
     }
 
     setSystemCurrentOperatingMode();
@@ -540,18 +669,17 @@ void SystemStatus::initSystemOperatingParameters()
 void SystemStatus::setSystemCurrentOperatingMode()
 {
     if (loggingPolicy == true &&
-        powerPolicy == "xyz.openbmc_project.Control.Power.RestorePolicy.Policy."
-                       "AlwaysOff" &&
+        powerPolicy == types::RestorePolicy::ALWAYS_OFF &&
         rebootPolicy == false)
     {
-        std::cout << "System operating mode set to Manual" << std::endl;
-        stateManager->setSystemOperatingMode("Manual");
+        log::info(log::Category::BUS, "System operating mode set to Manual");
+        stateManager->setSystemOperatingMode(types::OperatingMode::MANUAL);
     }
     else
     {
         // if any of the condition fails set mode to normal
-        std::cout << "System operating mode set to Normal" << std::endl;
-        stateManager->setSystemOperatingMode("Normal");
+        log::info(log::Category::BUS, "System operating mode set to Normal");
+        stateManager->setSystemOperatingMode(types::OperatingMode::NORMAL);
     }
 }
 } // namespace panel
\ No newline at end of file
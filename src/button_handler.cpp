@@ -1,5 +1,8 @@
 #include "button_handler.hpp"
 
+#include "logger.hpp"
+#include "loop_monitor.hpp"
+#include "metrics.hpp"
 #include "panel_state_manager.hpp"
 
 #include <assert.h>
@@ -50,6 +53,7 @@ void ButtonHandler::performAsyncRead()
         *streamDescriptor, boost::asio::buffer(ipEvent),
         boost::asio::transfer_at_least(sizeof(input_event)),
         [this](const boost::system::error_code& ec, size_t bytesTransferred) {
+            LoopMonitor::HandlerScope scope("processInputEvent");
             processInputEvent(ec, bytesTransferred);
         });
 }
@@ -67,15 +71,17 @@ void ButtonHandler::processInputEvent(const boost::system::error_code& ec,
 
         for (auto& ev : std::views::counted(ipEvent.begin(), numOfEvents))
         {
-            std::cout << "Received event type: " << ev.type << std::endl
-                      << " event code = " << ev.code << std::endl
-                      << " event value = " << ev.value << std::endl;
+            log::debug(log::Category::TRANSPORT, "Received event type: ",
+                       ev.type, " event code = ", ev.code, " event value = ",
+                       ev.value);
 
             // process only for release event i.e. 1
             if (ev.value == 0)
             {
                 return;
             }
+            metrics::get().buttonEvents.increment();
+
             switch (ev.code)
             {
                 case BTN_NORTH:
@@ -1,17 +1,28 @@
 #include "executor.hpp"
 
+#include "async_utils.hpp"
 #include "const.hpp"
 #include "exception.hpp"
+#include "logger.hpp"
 #include "utils.hpp"
 
 #include <boost/algorithm/string.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <string_view>
 
 namespace panel
 {
-void Executor::displayExecutionStatus(
-    const types::FunctionNumber funcNumber,
-    const types::FunctionalityList& subFuncNumber, const bool result)
+/**
+ * @brief Get the display of a function number along with its sub function.
+ * @param[in] funcNumber - function number
+ * @param[in] subFuncNumber - sub function number list
+ * @return Function number as displayed.
+ */
+static std::string
+    getFunctionString(const types::FunctionNumber funcNumber,
+                      const types::FunctionalityList& subFuncNumber)
 {
     std::ostringstream convert;
     convert << std::setfill('0') << std::setw(2)
@@ -26,20 +37,96 @@ void Executor::displayExecutionStatus(
     {
         convert << "   ";
     }
+    return convert.str();
+}
 
-    convert << (result ? " 00" : " FF");
-    utils::sendCurrDisplayToPanel(convert.str(), "", transport);
+void Executor::displayExecutionStatus(
+    const types::FunctionNumber funcNumber,
+    const types::FunctionalityList& subFuncNumber, const bool result)
+{
+    if (!result)
+    {
+        // a failed function can be executed again right away.
+        destructiveExecutedAt.erase(funcNumber);
+    }
+
+    utils::sendCurrDisplayToPanel(getFunctionString(funcNumber, subFuncNumber) +
+                                      (result ? " 00" : " FF"),
+                                  "", transport);
+}
+
+bool Executor::isDestructive(const types::FunctionNumber funcNumber,
+                             const types::FunctionalityList& subFuncNumber)
+{
+    // sub function 00 of 55 only views the dump policy.
+    if (funcNumber == 55)
+    {
+        return !subFuncNumber.empty() && subFuncNumber.at(0) != 0x00;
+    }
+    return funcNumber == 3 || funcNumber == 8 || funcNumber == 42 ||
+           funcNumber == 43 || funcNumber == 73;
+}
+
+bool Executor::admitFunction(const types::FunctionNumber funcNumber,
+                             const types::FunctionalityList& subFuncNumber)
+{
+    const auto inFlight = functionsInFlight.find(funcNumber);
+    if (inFlight != functionsInFlight.end() && isPrefetchable(funcNumber))
+    {
+        // a cancelled display is executed again.
+        if (inFlight->second == currentExecution)
+        {
+            log::debug(log::Category::EXECUTOR, "Function ",
+                       static_cast<int>(funcNumber),
+                       " already being executed.");
+            metrics::get().functionsCoalesced.increment();
+            return false;
+        }
+        return true;
+    }
+
+    auto busy = inFlight != functionsInFlight.end();
+
+    const auto now = std::chrono::steady_clock::now();
+    if (!busy && isDestructive(funcNumber, subFuncNumber))
+    {
+        const auto executedAt = destructiveExecutedAt.find(funcNumber);
+        busy = executedAt != destructiveExecutedAt.end() &&
+               now - executedAt->second < confirmationWindow;
+    }
+
+    if (busy)
+    {
+        log::info(log::Category::EXECUTOR, "Function ",
+                  static_cast<int>(funcNumber), " busy, press rejected.");
+        metrics::get().functionsRejected.increment();
+        utils::sendCurrDisplayToPanel(
+            getFunctionString(funcNumber, subFuncNumber), "BUSY", transport);
+        return false;
+    }
+
+    if (isDestructive(funcNumber, subFuncNumber))
+    {
+        destructiveExecutedAt[funcNumber] = now;
+    }
+    return true;
+}
+
+void Executor::startFunction(const types::FunctionNumber funcNumber)
+{
+    functionsInFlight[funcNumber] = currentExecution;
 }
 
 void Executor::executeFunction(const types::FunctionNumber funcNumber,
                                const types::FunctionalityList& subFuncNumber)
 {
-    // test output, to be removed
-    std::cout << funcNumber << std::endl;
+    log::debug(log::Category::EXECUTOR, "Execute function ",
+               static_cast<int>(funcNumber), " sub function ",
+               subFuncNumber.empty() ? -1 : subFuncNumber.at(0));
 
-    if (!subFuncNumber.empty())
+    if (!admitFunction(funcNumber, subFuncNumber))
     {
-        std::cout << subFuncNumber.at(0) << std::endl;
+        return;
     }
 
     try
@@ -47,11 +134,13 @@ void Executor::executeFunction(const types::FunctionNumber funcNumber,
         switch (funcNumber)
         {
             case 1:
-                execute01();
+                spawnFunction(1, subFuncNumber,
+                              executeDisplay(1, 0, startExecution()));
                 break;
 
             case 2:
-                execute02(subFuncNumber);
+                startExecution();
+                spawnFunction(2, subFuncNumber, execute02(subFuncNumber));
                 break;
 
             case 3:
@@ -87,10 +176,32 @@ void Executor::executeFunction(const types::FunctionNumber funcNumber,
                 execute14to19(funcNumber);
                 break;
             case 20:
-                execute20();
+                if (vpdDisplay)
+                {
+                    utils::sendDisplayFrameToPanel(*vpdDisplay, transport);
+                    break;
+                }
+                spawnFunction(20, subFuncNumber,
+                              executeDisplay(20, 0, startExecution()));
+                break;
+
+            case 21:
+            case 22:
+            case 34:
+            case 41:
+            case 65:
+            case 66:
+            case 67:
+            case 68:
+            case 69:
+            case 70:
+                executePhypFunction(funcNumber);
                 break;
+
             case 30:
-                execute30(subFuncNumber);
+                spawnFunction(
+                    30, subFuncNumber,
+                    executeDisplay(30, subFuncNumber.at(0), startExecution()));
                 break;
 
             case 42:
@@ -123,63 +234,427 @@ void Executor::executeFunction(const types::FunctionNumber funcNumber,
     }
     catch (BaseException& e)
     {
-        std::cerr << e.what() << std::endl;
+        log::error(log::Category::EXECUTOR, e.what());
         displayExecutionStatus(funcNumber, subFuncNumber, false);
     }
     catch (const sdbusplus::exception::SdBusError& e)
     {
-        std::cerr << e.what() << std::endl;
+        log::error(log::Category::EXECUTOR, e.what());
         displayExecutionStatus(funcNumber, subFuncNumber, false);
     }
 }
 
-void Executor::execute03()
+void Executor::cancelExecution()
+{
+    currentExecution++;
+}
+
+uint64_t Executor::startExecution()
+{
+    if (conn == nullptr)
+    {
+        throw FunctionFailure("D-Bus connection not available.");
+    }
+    return ++currentExecution;
+}
+
+void Executor::checkCancelled(uint64_t execution) const
+{
+    if (execution != currentExecution)
+    {
+        throw ExecutionCancelled("Function execution cancelled.");
+    }
+}
+
+void Executor::spawnFunction(const types::FunctionNumber funcNumber,
+                             const types::FunctionalityList& subFuncNumber,
+                             boost::asio::awaitable<void> function)
+{
+    startFunction(funcNumber);
+
+    boost::asio::co_spawn(
+        conn->get_io_context(), std::move(function),
+        [this, funcNumber, subFuncNumber,
+         execution = currentExecution](std::exception_ptr error) {
+            // unless the function is being executed again meanwhile.
+            const auto inFlight = functionsInFlight.find(funcNumber);
+            if (inFlight != functionsInFlight.end() &&
+                inFlight->second == execution)
+            {
+                functionsInFlight.erase(inFlight);
+            }
+
+            if (!error)
+            {
+                return;
+            }
+
+            try
+            {
+                std::rethrow_exception(error);
+            }
+            catch (const ExecutionCancelled& e)
+            {
+                log::debug(log::Category::EXECUTOR, "Function ",
+                           static_cast<int>(funcNumber), ": ", e.what());
+            }
+            catch (const std::exception& e)
+            {
+                log::error(log::Category::EXECUTOR, e.what());
+                displayExecutionStatus(funcNumber, subFuncNumber, false);
+            }
+        });
+}
+
+bool Executor::isPrefetchable(const types::FunctionNumber funcNumber)
+{
+    return funcNumber == 1 || funcNumber == 20 || funcNumber == 30;
+}
+
+void Executor::prefetch(const types::FunctionNumber funcNumber)
+{
+    if (conn == nullptr || !isPrefetchable(funcNumber) ||
+        (funcNumber == 20 && vpdDisplay))
+    {
+        return;
+    }
+
+    // function 30 displays either of the two ethernet ports.
+    if (funcNumber == 30)
+    {
+        startPrefetch(std::make_pair(funcNumber, 0));
+        startPrefetch(std::make_pair(funcNumber, 1));
+        return;
+    }
+    startPrefetch(std::make_pair(funcNumber, 0));
+}
+
+void Executor::loadVpdDisplay()
+{
+    if (conn == nullptr)
+    {
+        return;
+    }
+
+    // a load started later has the latest VPD.
+    const auto load = ++vpdDisplayLoad;
+    invalidateDisplay(20);
+
+    boost::asio::co_spawn(
+        conn->get_io_context(), fetch20(),
+        [this, load](std::exception_ptr error, Display display) {
+            if (load != vpdDisplayLoad)
+            {
+                return;
+            }
+
+            if (error)
+            {
+                // function 20 reads D-Bus until the VPD is loaded.
+                log::debug(log::Category::EXECUTOR,
+                           "Display of function 20 not loaded.");
+                vpdDisplay.reset();
+                return;
+            }
+            vpdDisplay = utils::makeDisplayFrame(display.first, display.second);
+        });
+}
+
+void Executor::invalidateDisplay(const types::FunctionNumber funcNumber)
+{
+    auto it = prefetched.lower_bound(DisplayKey{funcNumber, 0});
+    while (it != prefetched.end() && it->first.first == funcNumber)
+    {
+        // an execution waiting for the prefetch fetches the display again.
+        if (it->second.ready)
+        {
+            it->second.ready->cancel();
+        }
+        it = prefetched.erase(it);
+    }
+    displaysInvalidated++;
+}
+
+void Executor::startPrefetch(const DisplayKey& key)
+{
+    auto it = prefetched.find(key);
+    if (it != prefetched.end() &&
+        (it->second.ready ||
+         std::chrono::steady_clock::now() - it->second.fetchedAt < prefetchTtl))
+    {
+        // already being fetched, or fetched recently.
+        return;
+    }
+
+    auto& entry = prefetched[key];
+    entry.ready = std::make_shared<boost::asio::steady_timer>(
+        conn->get_io_context(), boost::asio::steady_timer::time_point::max());
+    metrics::get().prefetches.increment();
+
+    boost::asio::co_spawn(
+        conn->get_io_context(), fetchDisplay(key),
+        [this, key, ready = entry.ready](std::exception_ptr error,
+                                         Display display) {
+            // dropped meanwhile, the display fetched could be stale.
+            auto it = prefetched.find(key);
+            if (it == prefetched.end() || it->second.ready != ready)
+            {
+                return;
+            }
+
+            // wake up the execution waiting for this prefetch.
+            it->second.ready->cancel();
+            it->second.ready.reset();
+
+            if (error)
+            {
+                log::debug(log::Category::EXECUTOR, "Prefetch of function ",
+                           static_cast<int>(key.first), " failed.");
+                prefetched.erase(it);
+                return;
+            }
+            it->second.display = std::move(display);
+            it->second.fetchedAt = std::chrono::steady_clock::now();
+        });
+}
+
+boost::asio::awaitable<Executor::Display>
+    Executor::fetchDisplay(DisplayKey key)
+{
+    switch (key.first)
+    {
+        case 1:
+            co_return co_await fetch01();
+
+        case 20:
+            co_return co_await fetch20();
+
+        case 30:
+            co_return co_await fetch30(key.second);
+
+        default:
+            throw FunctionFailure("Function has no display to fetch.");
+    }
+}
+
+boost::asio::awaitable<Executor::Display>
+    Executor::getDisplay(DisplayKey key)
+{
+    auto it = prefetched.find(key);
+    if (it != prefetched.end() && it->second.ready)
+    {
+        // prefetch is in flight, wait for it instead of fetching again.
+        auto ready = it->second.ready;
+        try
+        {
+            co_await ready->async_wait(boost::asio::use_awaitable);
+        }
+        catch (const boost::system::system_error&)
+        {
+            // cancelled once the prefetch completes.
+        }
+        it = prefetched.find(key);
+    }
+
+    if (it != prefetched.end() && !it->second.ready &&
+        std::chrono::steady_clock::now() - it->second.fetchedAt < prefetchTtl)
+    {
+        metrics::get().prefetchHits.increment();
+        co_return it->second.display;
+    }
+
+    metrics::get().prefetchMisses.increment();
+    const auto invalidated = displaysInvalidated;
+    auto display = co_await fetchDisplay(key);
+
+    // keep it for another execution within the TTL, unless it could be stale.
+    if (invalidated == displaysInvalidated)
+    {
+        auto& entry = prefetched[key];
+        if (!entry.ready)
+        {
+            entry.display = display;
+            entry.fetchedAt = std::chrono::steady_clock::now();
+        }
+    }
+    co_return display;
+}
+
+boost::asio::awaitable<void>
+    Executor::executeDisplay(const types::FunctionNumber funcNumber,
+                             const types::FunctionNumber subFuncNumber,
+                             uint64_t execution)
 {
-    utils::writeBusProperty<std::string>(
-        "xyz.openbmc_project.State.Host", "/xyz/openbmc_project/state/host0",
-        "xyz.openbmc_project.State.Host", "RequestedHostTransition",
-        "xyz.openbmc_project.State.Host.Transition.GracefulWarmReboot");
+    const auto display =
+        co_await getDisplay(std::make_pair(funcNumber, subFuncNumber));
+    checkCancelled(execution);
 
-    utils::sendCurrDisplayToPanel("RESTART SERVER", "INITIATED", transport);
+    utils::sendCurrDisplayToPanel(display.first, display.second, transport);
 }
 
-void Executor::execute20()
+void Executor::executeBlocking(const types::FunctionNumber funcNumber,
+                               WorkerPool::Work calls,
+                               std::function<void()> onSuccess)
 {
-    auto res = utils::readBusProperty<std::variant<std::string>>(
-        "xyz.openbmc_project.Inventory.Manager",
-        "/xyz/openbmc_project/inventory/system",
-        "xyz.openbmc_project.Inventory.Decorator.Asset", "SerialNumber");
+    if (workers == nullptr)
+    {
+        // failure is handled by executeFunction.
+        calls();
+        if (onSuccess)
+        {
+            onSuccess();
+        }
+        return;
+    }
+
+    startFunction(funcNumber);
+    commandQueue.push_back(Command{funcNumber, std::move(calls),
+                                   std::move(onSuccess),
+                                   std::chrono::steady_clock::now()});
+    metrics::get().commandQueueDepth.set(commandQueue.size());
+
+    dispatchCommands();
+}
+
+void Executor::dispatchCommands()
+{
+    if (commandInFlight || commandQueue.empty())
+    {
+        return;
+    }
+
+    auto command = std::move(commandQueue.front());
+    commandQueue.pop_front();
+
+    metrics::get().commandQueueDepth.set(commandQueue.size());
+    metrics::get().commandWait.observe(std::chrono::steady_clock::now() -
+                                       command.queuedAt);
+
+    commandInFlight = true;
+    workers->submit(
+        std::move(command.calls),
+        [this, funcNumber = command.funcNumber,
+         onSuccess = std::move(command.onSuccess)](std::exception_ptr error) {
+            commandInFlight = false;
+            functionsInFlight.erase(funcNumber);
+
+            try
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+                if (onSuccess)
+                {
+                    onSuccess();
+                }
+            }
+            catch (const std::exception& e)
+            {
+                log::error(log::Category::EXECUTOR, e.what());
+                displayExecutionStatus(funcNumber, types::FunctionalityList{},
+                                       false);
+            }
+
+            // make the calls of the functions queued meanwhile.
+            dispatchCommands();
+        });
+}
+
+void Executor::requestTransition(
+    const types::FunctionNumber funcNumber,
+    const std::chrono::steady_clock::time_point& requestedAt,
+    const std::string& service, const std::string& object,
+    const std::string& interface, const std::string& property,
+    const std::string& transition, std::function<void()> onAccepted)
+{
+    if (hostControlConn == nullptr)
+    {
+        throw FunctionFailure("D-Bus connection not available.");
+    }
+
+    startFunction(funcNumber);
+    hostControlConn->async_method_call(
+        [this, funcNumber, requestedAt,
+         latency = &metrics::get().getDbusCallLatency(service),
+         sentAt = std::chrono::steady_clock::now(),
+         onAccepted = std::move(onAccepted)](boost::system::error_code ec) {
+            latency->observe(std::chrono::steady_clock::now() - sentAt);
+            if (completePriorityCall(funcNumber, ec))
+            {
+                metrics::get().priorityDispatch.observe(
+                    std::chrono::steady_clock::now() - requestedAt);
+                onAccepted();
+            }
+        },
+        service, object, "org.freedesktop.DBus.Properties", "Set", interface,
+        property, std::variant<std::string>(transition));
+}
+
+bool Executor::completePriorityCall(const types::FunctionNumber funcNumber,
+                                    const boost::system::error_code& ec)
+{
+    functionsInFlight.erase(funcNumber);
+
+    if (ec)
+    {
+        log::error(log::Category::EXECUTOR, "Function ",
+                   static_cast<int>(funcNumber), " failed: ", ec.message());
+        displayExecutionStatus(funcNumber, types::FunctionalityList{}, false);
+        return false;
+    }
+    return true;
+}
+
+void Executor::execute03()
+{
+    requestTransition(
+        3, std::chrono::steady_clock::now(), "xyz.openbmc_project.State.Host",
+        "/xyz/openbmc_project/state/host0", "xyz.openbmc_project.State.Host",
+        "RequestedHostTransition",
+        "xyz.openbmc_project.State.Host.Transition.GracefulWarmReboot",
+        [this]() {
+            utils::sendCurrDisplayToPanel("RESTART SERVER", "INITIATED",
+                                          transport);
+        });
+}
+
+boost::asio::awaitable<Executor::Display> Executor::fetch20()
+{
+    const std::string motherboard =
+        "/xyz/openbmc_project/inventory/system/chassis/motherboard";
+
+    // serial number, machine type and CCIN are read in one round trip
+    std::vector<types::ObjectInterface> interfaces;
+    interfaces.emplace_back("/xyz/openbmc_project/inventory/system",
+                            constants::assetIntf);
+    interfaces.emplace_back(motherboard, constants::vsysInterface);
+    interfaces.emplace_back(motherboard, constants::assetIntf);
+
+    const auto properties = co_await utils::asyncGetAllProperties(
+        *conn, constants::inventoryManagerIntf, std::move(interfaces));
 
     std::string line1(16, ' ');
     std::string line2(16, ' ');
 
-    const auto serialNumber = std::get_if<std::string>(&res);
+    const auto serialNumber =
+        utils::getProperty<std::string>(properties[0], "SerialNumber");
     if (serialNumber != nullptr)
     {
         line2.replace(0, (*serialNumber).length(), *serialNumber);
     }
 
-    // reading machine model type
-    auto resValue = utils::readBusProperty<std::variant<types::Binary>>(
-        "xyz.openbmc_project.Inventory.Manager",
-        "/xyz/openbmc_project/inventory/system/chassis/motherboard",
-        "com.ibm.ipzvpd.VSYS", "TM");
-
-    const auto propData = std::get_if<types::Binary>(&resValue);
-
+    // machine model type
+    const auto propData =
+        utils::getProperty<types::Binary>(properties[1], "TM");
     if (propData != nullptr)
     {
         line1.replace(0, constants::tmKwdDataLength,
                       reinterpret_cast<const char*>(propData->data()));
     }
 
-    // reading CCIN
-    res = utils::readBusProperty<std::variant<std::string>>(
-        "xyz.openbmc_project.Inventory.Manager",
-        "/xyz/openbmc_project/inventory/system/chassis/motherboard",
-        "xyz.openbmc_project.Inventory.Decorator.Asset", "Model");
-
-    const auto model = std::get_if<std::string>(&res);
+    // CCIN
+    const auto model = utils::getProperty<std::string>(properties[2], "Model");
     if (model != nullptr)
     {
         line1.replace(11, constants::ccinDataLength, *model);
@@ -190,7 +665,7 @@ void Executor::execute20()
     {
         throw FunctionFailure("Function 20 failed.");
     }
-    utils::sendCurrDisplayToPanel(line1, line2, transport);
+    co_return Display{line1, line2};
 }
 
 void Executor::execute11()
@@ -210,13 +685,14 @@ void Executor::execute11()
         }
         else
         {
-            std::cerr << "Invalid srcData received = " << srcData << std::endl;
+            log::error(log::Category::EXECUTOR, "Invalid srcData received = ",
+                       srcData);
         }
         return;
     }
 
     // TODO: Decide what needs to be done in this case.
-    std::cerr << "Error getting SRC data" << std::endl;
+    log::error(log::Category::EXECUTOR, "Error getting SRC data");
 }
 
 static std::string getEthObjByIntf(const std::string& portName)
@@ -232,31 +708,50 @@ static std::string getEthObjByIntf(const std::string& portName)
     return invEthObj;
 }
 
-static std::string getEthernetMac(const std::string& portName)
+/**
+ * @brief Read the MAC address and location code of the inventory ethernet
+ * objects.
+ *
+ * Both ports are read in one round trip.
+ *
+ * @param[in] conn - D-Bus connection.
+ * @param[in] ports - Names of the ports.
+ * @return Pair of MAC address and location code of each port.
+ */
+static boost::asio::awaitable<std::vector<std::pair<std::string, std::string>>>
+    getEthernetInventory(sdbusplus::asio::connection& conn,
+                         const std::vector<std::string>& ports)
 {
-    std::string invEthObj = getEthObjByIntf(portName);
     const auto nwItemIntf =
         "xyz.openbmc_project.Inventory.Item.NetworkInterface";
-    auto ethMac = utils::readBusProperty<std::variant<std::string>>(
-        constants::inventoryManagerIntf, invEthObj, nwItemIntf, "MACAddress");
-    if (auto p = std::get_if<std::string>(&ethMac))
+
+    std::vector<types::ObjectInterface> interfaces;
+    for (const auto& port : ports)
     {
-        return *p;
+        const auto invEthObj = getEthObjByIntf(port);
+        interfaces.emplace_back(invEthObj, nwItemIntf);
+        interfaces.emplace_back(invEthObj, constants::locCodeIntf);
     }
-    return {};
-}
 
-static std::string getEthernetLocation(const std::string& portName)
-{
-    std::string invEthObj = getEthObjByIntf(portName);
-    auto locCode = utils::readBusProperty<std::variant<std::string>>(
-        constants::inventoryManagerIntf, invEthObj, constants::locCodeIntf,
-        "LocationCode");
-    if (auto p = std::get_if<std::string>(&locCode))
+    const auto properties = co_await utils::asyncGetAllProperties(
+        conn, constants::inventoryManagerIntf, std::move(interfaces));
+
+    std::vector<std::pair<std::string, std::string>> ethernets;
+    for (size_t index = 0; index < ports.size(); ++index)
     {
-        return *p;
+        auto& ethernet = ethernets.emplace_back();
+        if (auto p = utils::getProperty<std::string>(properties[2 * index],
+                                                     "MACAddress"))
+        {
+            ethernet.first = *p;
+        }
+        if (auto p = utils::getProperty<std::string>(properties[2 * index + 1],
+                                                     "LocationCode"))
+        {
+            ethernet.second = *p;
+        }
     }
-    return {};
+    co_return ethernets;
 }
 
 static std::string getPortSegment(const std::string& locCode)
@@ -267,15 +762,16 @@ static std::string getPortSegment(const std::string& locCode)
     return loc;
 }
 
-void Executor::execute30(const types::FunctionalityList& subFuncNumber)
+boost::asio::awaitable<Executor::Display>
+    Executor::fetch30(types::FunctionNumber subFuncNumber)
 {
     // call Get Managed Objects for Network manager
-    const auto& networkObjects = utils::getManagedObjects(
-        constants::networkManagerService, constants::networkManagerObj);
+    const auto networkObjects = co_await utils::asyncGetManagedObjects(
+        *conn, constants::networkManagerService, constants::networkManagerObj);
 
     std::string ethPort = "eth0";
     std::string otherPort = "eth1";
-    if (subFuncNumber.at(0) == 0x01) // eth1
+    if (subFuncNumber == 0x01) // eth1
     {
         ethPort = "eth1";
         otherPort = "eth0";
@@ -349,12 +845,14 @@ void Executor::execute30(const types::FunctionalityList& subFuncNumber)
                 });
             if (intfItr == intfPropVector.end())
             {
-                std::cerr << "Mac address interface not found." << std::endl;
+                log::error(log::Category::EXECUTOR,
+                           "Mac address interface not found.");
             }
             const auto& macAddrItr = intfItr->second.find("MACAddress");
             if (macAddrItr == intfItr->second.end())
             {
-                std::cerr << "MACAddress property not found." << std::endl;
+                log::error(log::Category::EXECUTOR,
+                           "MACAddress property not found.");
             }
             if (auto mac = std::get_if<std::string>(&(macAddrItr->second)))
             {
@@ -372,18 +870,21 @@ void Executor::execute30(const types::FunctionalityList& subFuncNumber)
     // objects(network & inventory eth objects)matches, take loc code from
     // the respective inv manager obj path.
 
-    if (macAddr == getEthernetMac(ethPort))
+    const std::vector<std::string> ports{ethPort, otherPort};
+    const auto ethernets = co_await getEthernetInventory(*conn, ports);
+
+    if (macAddr == ethernets[0].first)
     {
-        locCode = getEthernetLocation(ethPort);
+        locCode = ethernets[0].second;
     }
-    else if (macAddr == getEthernetMac(otherPort))
+    else if (macAddr == ethernets[1].first)
     {
-        locCode = getEthernetLocation(otherPort);
+        locCode = ethernets[1].second;
     }
     else
     {
-        std::cerr << "\n No matching ethernet object in Inventory Manager. "
-                  << std::endl;
+        log::error(log::Category::EXECUTOR,
+                   "No matching ethernet object in Inventory Manager.");
     }
 
     if (!locCode.empty())
@@ -401,7 +902,7 @@ void Executor::execute30(const types::FunctionalityList& subFuncNumber)
     line1 += boost::to_upper_copy<std::string>(ethPort);
     line1 += ":      ";
     line1 += locCode;
-    panel::utils::sendCurrDisplayToPanel(line1, line2, transport);
+    co_return Display{line1, line2};
 }
 
 bool Executor::isOSIPLTypeEnabled() const
@@ -411,9 +912,9 @@ bool Executor::isOSIPLTypeEnabled() const
     return false;
 }
 
-void Executor::execute01()
+boost::asio::awaitable<Executor::Display> Executor::fetch01()
 {
-    const auto sysValues = utils::readSystemParameters();
+    const auto sysValues = co_await utils::asyncReadSystemParameters(*conn);
 
     std::string line1(16, ' ');
     std::string line2(16, ' ');
@@ -445,8 +946,7 @@ void Executor::execute01()
     }
 
     // read the next boot side selected
-    std::string nextBootSide{};
-    utils::getNextBootSide(nextBootSide);
+    const auto nextBootSide = co_await utils::asyncGetNextBootSide(*conn);
 
     // Add boot side to display.
     line2.replace(12, 1, nextBootSide);
@@ -459,8 +959,7 @@ void Executor::execute01()
     // function number
     line1.replace(0, 2, "01");
 
-    utils::sendCurrDisplayToPanel(line1, line2, transport);
-    return;
+    co_return Display{line1, line2};
 }
 
 void Executor::execute12()
@@ -619,8 +1118,9 @@ static std::string getIplType(const uint8_t index)
     }
 }
 
-static types::PendingAttributesItemType
-    setOperatingMode(const uint8_t sysOperatingModeIndex)
+static boost::asio::awaitable<types::PendingAttributesItemType>
+    setOperatingMode(sdbusplus::asio::connection& conn,
+                     const uint8_t sysOperatingModeIndex)
 {
     // Normal mode is the default mode hence all the defaul values are as
     // per normal mode.
@@ -639,143 +1139,171 @@ static types::PendingAttributesItemType
         autoReboot = false;
     }
 
-    utils::writeBusProperty<bool>("xyz.openbmc_project.Settings",
-                                  "/xyz/openbmc_project/logging/settings",
-                                  "xyz.openbmc_project.Logging.Settings",
-                                  "QuiesceOnHwError", QuiesceOnHwError);
+    co_await utils::asyncWriteBusProperty<bool>(
+        conn, "xyz.openbmc_project.Settings",
+        "/xyz/openbmc_project/logging/settings",
+        "xyz.openbmc_project.Logging.Settings", "QuiesceOnHwError",
+        QuiesceOnHwError);
 
-    utils::writeBusProperty<std::string>(
-        "xyz.openbmc_project.Settings",
+    co_await utils::asyncWriteBusProperty<std::string>(
+        conn, "xyz.openbmc_project.Settings",
         "/xyz/openbmc_project/control/host0/power_restore_policy",
         "xyz.openbmc_project.Control.Power.RestorePolicy", "PowerRestorePolicy",
         PowerRestorePolicy);
 
-    utils::writeBusProperty<bool>(
-        "xyz.openbmc_project.Settings",
+    co_await utils::asyncWriteBusProperty<bool>(
+        conn, "xyz.openbmc_project.Settings",
         "/xyz/openbmc_project/control/host0/auto_reboot",
         "xyz.openbmc_project.Control.Boot.RebootPolicy", "AutoReboot",
         autoReboot);
 
-    return std::make_pair(
+    co_return std::make_pair(
         "pvm_system_operating_mode",
         std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
                         "AttributeType.Enumeration",
                         sysOperatingModeValue));
 }
 
-static void bootSideSwitch()
+static boost::asio::awaitable<void>
+    bootSideSwitch(sdbusplus::asio::connection& conn)
 {
-    const auto bootSidePaths = utils::getBootSidePaths();
+    const auto bootSidePaths = co_await utils::asyncGetBootSidePaths(conn);
 
     if (bootSidePaths.size() != 0)
     {
         if (bootSidePaths.size() > 2)
         {
-            std::cout << "Received more than two boot paths, Setting the "
-                         "first path with priority 1 as next boot path"
-                      << std::endl;
+            log::warning(log::Category::EXECUTOR,
+                         "Received more than two boot paths, Setting the first "
+                         "path with priority 1 as next boot path");
         }
 
         for (const auto& path : bootSidePaths)
         {
-            auto retVal = utils::readBusProperty<std::variant<uint8_t>>(
-                "xyz.openbmc_project.Software.BMC.Updater", path,
-                "xyz.openbmc_project.Software.RedundancyPriority", "Priority");
+            auto retVal =
+                co_await utils::asyncReadBusProperty<std::variant<uint8_t>>(
+                    conn, "xyz.openbmc_project.Software.BMC.Updater", path,
+                    "xyz.openbmc_project.Software.RedundancyPriority",
+                    "Priority");
 
             if (auto priority = std::get_if<uint8_t>(&retVal))
             {
                 if (*priority != 0)
                 {
                     uint8_t value = 0;
-                    utils::writeBusProperty<uint8_t>(
-                        "xyz.openbmc_project.Software.BMC.Updater", path,
+                    co_await utils::asyncWriteBusProperty<uint8_t>(
+                        conn, "xyz.openbmc_project.Software.BMC.Updater", path,
                         "xyz.openbmc_project.Software.RedundancyPriority",
                         "Priority", value);
 
                     // once the value is updated no need to check for other
                     // paths.
-                    return;
+                    co_return;
                 }
             }
         }
     }
-    std::cerr << "No boot paths returned by mapper call. Hence boot switch "
-                 "not executed"
-              << std::endl;
+    log::error(log::Category::EXECUTOR,
+               "No boot paths returned by mapper call. Hence boot switch not "
+               "executed");
 }
 
-void Executor::execute02(const types::FunctionalityList& subFuncNumber)
+boost::asio::awaitable<void>
+    Executor::execute02(types::FunctionalityList subFuncNumber)
 {
     // 127 is sent in sub function number when the state is invalid.
     static constexpr auto invalidState = 127;
 
-    // BIOS table attribute list.
-    types::PendingAttributesType listOfAttributeValue;
-
-    // change is needed only when state is not invalid.
-    if (subFuncNumber.at(0) != invalidState)
+    try
     {
-        listOfAttributeValue.push_back(std::make_pair(
-            "pvm_os_boot_type",
-            std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
-                            "AttributeType.Enumeration",
-                            getIplType(subFuncNumber.at(0)))));
-    }
+        // BIOS table attribute list.
+        types::PendingAttributesType listOfAttributeValue;
 
-    if (subFuncNumber.at(1) != invalidState)
-    {
-        listOfAttributeValue.push_back(setOperatingMode(subFuncNumber.at(1)));
-    }
+        // change is needed only when state is not invalid.
+        if (subFuncNumber.at(0) != invalidState)
+        {
+            listOfAttributeValue.push_back(std::make_pair(
+                "pvm_os_boot_type",
+                std::make_tuple("xyz.openbmc_project.BIOSConfig.Manager."
+                                "AttributeType.Enumeration",
+                                getIplType(subFuncNumber.at(0)))));
+        }
 
-    // Process boot side switch only when state is not invalid. Implies
-    // change required.
-    if (subFuncNumber.at(2) != invalidState)
-    {
-        // switch boot side.
-        bootSideSwitch();
-    }
+        if (subFuncNumber.at(1) != invalidState)
+        {
+            listOfAttributeValue.push_back(
+                co_await setOperatingMode(*conn, subFuncNumber.at(1)));
+        }
 
-    if (listOfAttributeValue.size() > 0)
+        // Process boot side switch only when state is not invalid. Implies
+        // change required.
+        if (subFuncNumber.at(2) != invalidState)
+        {
+            // switch boot side.
+            co_await bootSideSwitch(*conn);
+        }
+
+        if (listOfAttributeValue.size() > 0)
+        {
+            co_await utils::asyncWriteBusProperty<
+                types::PendingAttributesType>(
+                *conn, "xyz.openbmc_project.BIOSConfigManager",
+                "/xyz/openbmc_project/bios_config/manager",
+                "xyz.openbmc_project.BIOSConfig.Manager", "PendingAttributes",
+                std::move(listOfAttributeValue));
+        }
+    }
+    catch (...)
     {
-        utils::writeBusProperty<types::PendingAttributesType>(
-            "xyz.openbmc_project.BIOSConfigManager",
-            "/xyz/openbmc_project/bios_config/manager",
-            "xyz.openbmc_project.BIOSConfig.Manager", "PendingAttributes",
-            std::move(listOfAttributeValue));
+        // some of the changes could have been made.
+        invalidateDisplay(1);
+        throw;
     }
+
+    // function 01 shows the values changed.
+    invalidateDisplay(1);
 }
 
-void Executor::storeIPLSRC(const std::string& progressCode)
+void Executor::storeIPLSRC(const decoder::ProgressCode& progressCode)
 {
-    // Need to store last 25 IPL SRCs.
-    if (iplSrcs.size() == 25)
+    // Need to store last 25 IPL SRCs, overwrite the oldest one once full.
+    if (iplSrcCount == maxIplSrcs)
     {
-        iplSrcs.pop_front();
+        iplSrcs[iplSrcStart] = progressCode;
+        iplSrcStart = (iplSrcStart + 1) % maxIplSrcs;
+        return;
     }
-    iplSrcs.push_back(progressCode);
+    iplSrcs[(iplSrcStart + iplSrcCount) % maxIplSrcs] = progressCode;
+    iplSrcCount++;
 }
 
 void Executor::execute63(const types::FunctionNumber subFuncNumber)
 {
     // 0th Sub function is always enabled and should show blank screen if
     // required.
-    if ((subFuncNumber == 0) && (iplSrcs.size() == 0))
+    if ((subFuncNumber == 0) && (iplSrcCount == 0))
     {
         utils::sendCurrDisplayToPanel(std::string{}, std::string{}, transport);
         return;
     }
     else
     {
-        if ((iplSrcs.size() - 1) >= subFuncNumber)
+        if (subFuncNumber < iplSrcCount)
         {
-            utils::sendCurrDisplayToPanel(iplSrcs.at(subFuncNumber),
-                                          std::string{}, transport);
+            // Reference code on line 1 and extended data(hex words) of the
+            // SRC on line 2.
+            const auto& progressCode =
+                iplSrcs.at((iplSrcStart + subFuncNumber) % maxIplSrcs);
+            utils::sendCurrDisplayToPanel(
+                std::string{progressCode.referenceCode()},
+                std::string{progressCode.hexWords()}, transport,
+                encoder::MessageEncoder::srcScrollRate);
             return;
         }
     }
 
-    std::cerr << "Sub function number should not have been enabled"
-              << std::endl;
+    log::error(log::Category::EXECUTOR,
+               "Sub function number should not have been enabled");
 }
 
 void Executor::storePelEventId(const std::string& pelEventId)
@@ -804,7 +1332,7 @@ void Executor::execute64(const types::FunctionNumber subFuncNumber)
             std::string_view src(pelEventIdQueue.at(subFuncNumber));
             if (src.length() < 8)
             {
-                std::cerr << "Bad error event data" << std::endl;
+                log::error(log::Category::EXECUTOR, "Bad error event data");
                 return;
             }
             // TODO: via https://github.com/ibm-openbmc/ibm-panel/issues/34.
@@ -815,8 +1343,8 @@ void Executor::execute64(const types::FunctionNumber subFuncNumber)
         }
     }
 
-    std::cerr << "Sub function number should not have been enabled"
-              << std::endl;
+    log::error(log::Category::EXECUTOR,
+               "Sub function number should not have been enabled");
 }
 
 void Executor::execute55(const types::FunctionalityList& subFuncNumber)
@@ -824,55 +1352,61 @@ void Executor::execute55(const types::FunctionalityList& subFuncNumber)
     /** dump policy: true(01), false(02) */
     if (subFuncNumber.at(0) == 0x00) // view dump policy
     {
-        auto result = utils::readBusProperty<std::variant<bool>>(
-            "xyz.openbmc_project.Settings",
-            "/xyz/openbmc_project/dump/system_dump_policy",
-            "xyz.openbmc_project.Object.Enable", "Enabled");
-
-        if (auto val = std::get_if<bool>(&result))
-        {
-            std::string line1 = "5500 ";
-            line1 += *val ? "01" : "02";
-            utils::sendCurrDisplayToPanel(line1, "", transport);
-            return;
-        }
-        else
-        {
-            throw FunctionFailure("Dump policy collection failed.");
-        }
-    }
-    else if (subFuncNumber.at(0) == 0x01) // disable dump policy
-    {
-        utils::writeBusProperty<bool>(
-            "xyz.openbmc_project.Settings",
-            "/xyz/openbmc_project/dump/system_dump_policy",
-            "xyz.openbmc_project.Object.Enable", "Enabled", false);
+        auto enabled = std::make_shared<bool>(false);
+        executeBlocking(
+            55,
+            [enabled]() {
+                auto result = utils::readBusProperty<std::variant<bool>>(
+                    "xyz.openbmc_project.Settings",
+                    "/xyz/openbmc_project/dump/system_dump_policy",
+                    "xyz.openbmc_project.Object.Enable", "Enabled");
+
+                if (auto val = std::get_if<bool>(&result))
+                {
+                    *enabled = *val;
+                    return;
+                }
+                throw FunctionFailure("Dump policy collection failed.");
+            },
+            [this, enabled]() {
+                std::string line1 = "5500 ";
+                line1 += *enabled ? "01" : "02";
+                utils::sendCurrDisplayToPanel(line1, "", transport);
+            });
     }
-    else if (subFuncNumber.at(0) == 0x02) // enable dump policy
+    else if (subFuncNumber.at(0) == 0x01 ||
+             subFuncNumber.at(0) == 0x02) // disable or enable dump policy
     {
-        utils::writeBusProperty<bool>(
-            "xyz.openbmc_project.Settings",
-            "/xyz/openbmc_project/dump/system_dump_policy",
-            "xyz.openbmc_project.Object.Enable", "Enabled", true);
+        executeBlocking(
+            55,
+            [enable = subFuncNumber.at(0) == 0x02]() {
+                utils::writeBusProperty<bool>(
+                    "xyz.openbmc_project.Settings",
+                    "/xyz/openbmc_project/dump/system_dump_policy",
+                    "xyz.openbmc_project.Object.Enable", "Enabled", enable);
+            },
+            [this, subFuncNumber]() {
+                displayExecutionStatus(55, subFuncNumber, true);
+            });
     }
     else
     {
         throw FunctionFailure("Function 55 failed. Unsupported sub function.");
     }
-
-    displayExecutionStatus(55, subFuncNumber, true);
 }
 
 void Executor::execute08()
 {
     // set the transition state of chassis to poweroff.
-    panel::utils::writeBusProperty<std::string>(
+    requestTransition(
+        8, std::chrono::steady_clock::now(),
         "xyz.openbmc_project.State.Chassis",
         "/xyz/openbmc_project/state/chassis0",
         "xyz.openbmc_project.State.Chassis", "RequestedPowerTransition",
-        "xyz.openbmc_project.State.Chassis.Transition.Off");
-
-    utils::sendCurrDisplayToPanel("SHUTDOWN SERVER", "INITIATED", transport);
+        "xyz.openbmc_project.State.Chassis.Transition.Off", [this]() {
+            utils::sendCurrDisplayToPanel("SHUTDOWN SERVER", "INITIATED",
+                                          transport);
+        });
 }
 
 static void createDump(const sdbusplus::message::object_path& object)
@@ -885,56 +1419,174 @@ static void createDump(const sdbusplus::message::object_path& object)
     properties.append(
         std::vector<
             std::pair<std::string, std::variant<std::string, uint64_t>>>());
+    metrics::CallTimer timer(
+        metrics::get().getDbusCallLatency("xyz.openbmc_project.Dump.Manager"));
     auto result = bus.call(properties);
     result.read(retVal);
-    std::cout << "Dump initiated. " << std::string(retVal) << std::endl;
+    log::info(log::Category::EXECUTOR, "Dump initiated. ", std::string(retVal));
 }
 
 void Executor::execute43()
 {
-    createDump(
-        sdbusplus::message::object_path("/xyz/openbmc_project/dump/bmc"));
-    displayExecutionStatus(43, std::vector<types::FunctionNumber>(), true);
+    executeBlocking(
+        43,
+        []() {
+            createDump(sdbusplus::message::object_path(
+                "/xyz/openbmc_project/dump/bmc"));
+        },
+        [this]() {
+            displayExecutionStatus(43, std::vector<types::FunctionNumber>(),
+                                   true);
+        });
 }
 
 void Executor::execute42()
 {
-    createDump(
-        sdbusplus::message::object_path("/xyz/openbmc_project/dump/system"));
-    displayExecutionStatus(42, std::vector<types::FunctionNumber>(), true);
+    executeBlocking(
+        42,
+        []() {
+            createDump(sdbusplus::message::object_path(
+                "/xyz/openbmc_project/dump/system"));
+        },
+        [this]() {
+            displayExecutionStatus(42, std::vector<types::FunctionNumber>(),
+                                   true);
+        });
 }
 
 void Executor::execute04()
 {
-    utils::writeBusProperty<bool>("xyz.openbmc_project.LED.GroupManager",
-                                  "/xyz/openbmc_project/led/groups/lamp_test",
-                                  "xyz.openbmc_project.Led.Group", "Asserted",
-                                  true);
-    utils::doLampTest(transport);
+    executeBlocking(
+        4,
+        []() {
+            utils::writeBusProperty<bool>(
+                "xyz.openbmc_project.LED.GroupManager",
+                "/xyz/openbmc_project/led/groups/lamp_test",
+                "xyz.openbmc_project.Led.Group", "Asserted", true);
+        },
+        [this]() { utils::doLampTest(transport); });
+}
+
+void Executor::executePhypFunction(const types::FunctionNumber funcNumber)
+{
+    if (pldm == nullptr || conn == nullptr)
+    {
+        throw FunctionFailure("PLDM not available to send function to PHYP.");
+    }
+
+    if (phypFunctionQueue.size() == maxPhypFunctionsQueued)
+    {
+        throw FunctionFailure("Too many functions queued for PHYP.");
+    }
+
+    std::ostringstream line1;
+    line1 << std::setfill('0') << std::setw(2) << static_cast<int>(funcNumber);
+    utils::sendCurrDisplayToPanel(line1.str(), "IN PROGRESS", transport);
+
+    // the result is displayed only if the operator stays on this press.
+    startExecution();
+    startFunction(funcNumber);
+    phypFunctionQueue.push_back(funcNumber);
+    dispatchPhypFunctions();
+}
+
+void Executor::dispatchPhypFunctions()
+{
+    while (phypFunctionsInFlight < maxPhypFunctionsInFlight &&
+           !phypFunctionQueue.empty())
+    {
+        const auto funcNumber = phypFunctionQueue.front();
+        phypFunctionQueue.pop_front();
+
+        // counted before it is sent, a failure can complete it right away.
+        phypFunctionsInFlight++;
+        try
+        {
+            pldm->sendPanelFunctionToPhyp(
+                funcNumber, [this, funcNumber](PldmStatus status,
+                                               types::Byte completionCode) {
+                    phypFunctionsInFlight--;
+                    if (status != PldmStatus::SUCCESS)
+                    {
+                        log::error(log::Category::EXECUTOR, "Function ",
+                                   static_cast<int>(funcNumber),
+                                   " failed in PHYP, status = ",
+                                   static_cast<int>(status),
+                                   ", completion code = ",
+                                   static_cast<int>(completionCode));
+                    }
+                    completePhypFunction(funcNumber,
+                                         status == PldmStatus::SUCCESS);
+
+                    // send the functions queued meanwhile, once out of the
+                    // dispatch this could be completed from.
+                    boost::asio::post(conn->get_io_context(),
+                                      [this]() { dispatchPhypFunctions(); });
+                });
+        }
+        catch (const FunctionFailure& e)
+        {
+            phypFunctionsInFlight--;
+            log::error(log::Category::EXECUTOR, e.what());
+            completePhypFunction(funcNumber, false);
+        }
+    }
 }
 
-static void doBMCGracefulRestart()
+void Executor::completePhypFunction(const types::FunctionNumber funcNumber,
+                                    const bool result)
 {
-    utils::writeBusProperty<std::string>(
-        "xyz.openbmc_project.State.BMC", "/xyz/openbmc_project/state/bmc0",
-        "xyz.openbmc_project.State.BMC", "RequestedBMCTransition",
-        "xyz.openbmc_project.State.BMC.Transition.Reboot");
+    const auto inFlight = functionsInFlight.find(funcNumber);
+    if (inFlight == functionsInFlight.end())
+    {
+        return;
+    }
+
+    // the panel has moved on if the operator left the function meanwhile.
+    const auto isCurrent = inFlight->second == currentExecution;
+    functionsInFlight.erase(inFlight);
+
+    if (isCurrent)
+    {
+        displayExecutionStatus(funcNumber, types::FunctionalityList{}, result);
+    }
 }
 
 void Executor::execute73()
 {
+    if (hostControlConn == nullptr)
+    {
+        throw FunctionFailure("D-Bus connection not available.");
+    }
+
     // factory reset BMC by calling
     // BMC code updater factory reset followed by a BMC reboot.
-    auto bus = sdbusplus::bus::new_default();
-    auto factoryResetCall =
-        bus.new_method_call("xyz.openbmc_project.Software.BMC.Updater",
-                            "/xyz/openbmc_project/software",
-                            "xyz.openbmc_project.Common.FactoryReset", "Reset");
-
-    bus.call(factoryResetCall);
+    static constexpr auto updaterService =
+        "xyz.openbmc_project.Software.BMC.Updater";
+
+    startFunction(73);
+    hostControlConn->async_method_call(
+        [this, requestedAt = std::chrono::steady_clock::now(),
+         latency = &metrics::get().getDbusCallLatency(updaterService)](
+            boost::system::error_code ec) {
+            latency->observe(std::chrono::steady_clock::now() - requestedAt);
+            if (!completePriorityCall(73, ec))
+            {
+                return;
+            }
 
-    // Factory Reset doesn't actually happen until a reboot
-    doBMCGracefulRestart();
+            // Factory Reset doesn't actually happen until a reboot
+            requestTransition(
+                73, requestedAt, "xyz.openbmc_project.State.BMC",
+                "/xyz/openbmc_project/state/bmc0",
+                "xyz.openbmc_project.State.BMC", "RequestedBMCTransition",
+                "xyz.openbmc_project.State.BMC.Transition.Reboot", [this]() {
+                    displayExecutionStatus(73, types::FunctionalityList{},
+                                           true);
+                });
+        },
+        updaterService, "/xyz/openbmc_project/software",
+        "xyz.openbmc_project.Common.FactoryReset", "Reset");
 }
 
 } // namespace panel
\ No newline at end of file
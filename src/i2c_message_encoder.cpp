@@ -73,26 +73,38 @@ Binary MessageEncoder::buttonControl(Byte buttonID, Byte buttonOperation)
     return encodedData;
 }
 
-Binary MessageEncoder::scroll(Byte scrollControl)
+Binary MessageEncoder::scroll(Byte scrollControl, Byte scrollRate,
+                              Byte scrollCount)
 {
     Binary encodedData;
     encodedData.reserve(6);
     encodedData.emplace_back(0xFF);
     encodedData.emplace_back(0x88);
     encodedData.emplace_back(scrollControl);
-    encodedData.emplace_back(10); // emplace scroll rate
-    encodedData.emplace_back(1);  // emplace scroll character count
+    encodedData.emplace_back(scrollRate);  // emplace scroll rate
+    encodedData.emplace_back(scrollCount); // emplace scroll character count
     calculateCheckSum(encodedData);
     return encodedData;
 }
 
+Binary MessageEncoder::scroll(ScrollType scrollType, Byte scrollRate,
+                              Byte scrollCount)
+{
+    return scroll(static_cast<Byte>(scrollType), scrollRate, scrollCount);
+}
+
+Binary MessageEncoder::stopScroll()
+{
+    return scroll(ScrollType::STOP);
+}
+
 Binary MessageEncoder::lampTest()
 {
     Binary encodedData;
     encodedData.reserve(4);
     encodedData.emplace_back(0xFF);
     encodedData.emplace_back(0x54);
-    encodedData.emplace_back(240); // emplace lamp test duration
+    encodedData.emplace_back(lampTestDuration);
     calculateCheckSum(encodedData);
     return encodedData;
 }
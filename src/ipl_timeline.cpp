@@ -0,0 +1,100 @@
+#include "ipl_timeline.hpp"
+
+namespace panel
+{
+void IplTimeline::recordProgressCode(std::string_view referenceCode,
+                                     Clock::time_point timeStamp)
+{
+    const auto prefix = referenceCode.substr(0, phasePrefixLength);
+
+    // Progress code going back to the first phase implies a re-IPL.
+    if (currentIpl.complete || currentIpl.phases.empty() ||
+        (prefix == currentIpl.phases.front().prefix &&
+         prefix != currentIpl.phases.back().prefix))
+    {
+        if (!currentIpl.phases.empty())
+        {
+            if (!currentIpl.complete)
+            {
+                // IPL got restarted, it ends with the last code received.
+                currentIpl.end = currentIpl.phases.back().lastCode;
+                currentIpl.complete = true;
+            }
+            previousIpl = std::move(currentIpl);
+        }
+        currentIpl = Ipl{};
+        currentIpl.phases.reserve(maxPhases);
+    }
+
+    if (currentIpl.phases.empty() || currentIpl.phases.back().prefix != prefix)
+    {
+        if (currentIpl.phases.size() == maxPhases)
+        {
+            // Keep accounting the time in the last phase.
+            currentIpl.phases.back().lastCode = timeStamp;
+            currentIpl.phases.back().codeCount++;
+            return;
+        }
+        currentIpl.phases.emplace_back(
+            Phase{std::string{prefix}, timeStamp, timeStamp, 0});
+    }
+
+    auto& phase = currentIpl.phases.back();
+    phase.lastCode = timeStamp;
+    phase.codeCount++;
+}
+
+void IplTimeline::endIpl(Clock::time_point timeStamp)
+{
+    if (isIplInProgress())
+    {
+        currentIpl.end = timeStamp;
+        currentIpl.complete = true;
+    }
+}
+
+IplTimeline::PhaseDurations
+    IplTimeline::getPhaseDurations(const Ipl& ipl, Clock::time_point now)
+{
+    PhaseDurations durations;
+    durations.reserve(ipl.phases.size());
+
+    for (auto it = ipl.phases.begin(); it != ipl.phases.end(); ++it)
+    {
+        // A phase lasts till the next phase is entered.
+        auto end = ipl.complete ? ipl.end : now;
+        if (it + 1 != ipl.phases.end())
+        {
+            end = (it + 1)->start;
+        }
+
+        durations.emplace_back(
+            it->prefix,
+            std::chrono::duration_cast<std::chrono::milliseconds>(end -
+                                                                  it->start)
+                .count());
+    }
+    return durations;
+}
+
+IplTimeline::PhaseDurations
+    IplTimeline::getCurrentIplPhases(Clock::time_point now) const
+{
+    return getPhaseDurations(currentIpl, now);
+}
+
+IplTimeline::PhaseDurations IplTimeline::getPreviousIplPhases() const
+{
+    return getPhaseDurations(previousIpl, previousIpl.end);
+}
+
+void IplTimeline::registerMethods(
+    std::shared_ptr<sdbusplus::asio::dbus_interface>& iface)
+{
+    iface->register_method("GetCurrentIPLPhases",
+                           [this]() { return getCurrentIplPhases(); });
+
+    iface->register_method("GetPreviousIPLPhases",
+                           [this]() { return getPreviousIplPhases(); });
+}
+} // namespace panel
@@ -0,0 +1,131 @@
+#include "logger.hpp"
+
+#include <systemd/sd-journal.h>
+
+#include <boost/asio/post.hpp>
+
+namespace panel
+{
+namespace log
+{
+static constexpr std::array<std::string_view,
+                            static_cast<size_t>(Category::COUNT)>
+    categoryNames = {"app", "transport", "state", "executor", "bus", "pldm"};
+
+std::string_view getCategoryName(Category category)
+{
+    return categoryNames[static_cast<size_t>(category)];
+}
+
+std::optional<Level> toLevel(std::string_view name)
+{
+    if (name == "error")
+    {
+        return Level::ERROR;
+    }
+    if (name == "warning")
+    {
+        return Level::WARNING;
+    }
+    if (name == "info")
+    {
+        return Level::INFO;
+    }
+    if (name == "debug")
+    {
+        return Level::DEBUG;
+    }
+    return std::nullopt;
+}
+
+static void writeToJournal(const Entry& entry)
+{
+    const auto category = getCategoryName(entry.category);
+
+    sd_journal_send("MESSAGE=%s", entry.message.c_str(), "PRIORITY=%d",
+                    static_cast<int>(entry.level), "PANEL_CATEGORY=%.*s",
+                    static_cast<int>(category.size()), category.data(),
+                    nullptr);
+}
+
+Logger& Logger::getInstance()
+{
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() : sink(writeToJournal)
+{
+    levels.fill(compiledLevel);
+    pending.reserve(maxBatchSize);
+}
+
+Logger::~Logger()
+{
+    flush();
+}
+
+void Logger::setLevel(Level level)
+{
+    levels.fill(level);
+}
+
+void Logger::setLevel(Category category, Level level)
+{
+    levels[static_cast<size_t>(category)] = level;
+}
+
+void Logger::attach(const std::shared_ptr<boost::asio::io_context>& io)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    flushPending();
+    this->io = io;
+    flushScheduled = false;
+}
+
+void Logger::setSink(Sink sink)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    flushPending();
+    this->sink = sink ? std::move(sink) : writeToJournal;
+}
+
+void Logger::write(Level level, Category category, std::string&& message)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.emplace_back(Entry{level, category, std::move(message)});
+
+    auto ioContext = io.lock();
+    if (!ioContext || level == Level::ERROR || pending.size() >= maxBatchSize)
+    {
+        flushPending();
+        return;
+    }
+
+    if (!flushScheduled)
+    {
+        flushScheduled = true;
+        boost::asio::post(*ioContext, [this]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            flushScheduled = false;
+            flushPending();
+        });
+    }
+}
+
+void Logger::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    flushPending();
+}
+
+void Logger::flushPending()
+{
+    for (const auto& entry : pending)
+    {
+        sink(entry);
+    }
+    pending.clear();
+}
+} // namespace log
+} // namespace panel
@@ -0,0 +1,123 @@
+#include "loop_monitor.hpp"
+
+#include "logger.hpp"
+#include "metrics.hpp"
+
+#include <systemd/sd-daemon.h>
+
+#include <algorithm>
+
+namespace panel
+{
+/* Handlers which took longer than the threshold. */
+static LoopMonitor::SlowHandlers slowHandlers;
+
+/* Slowest handler since the last probe, to attribute the lag to. */
+static std::string_view slowestHandler;
+static LoopMonitor::Clock::duration slowestDuration{};
+
+static uint64_t toMicroseconds(LoopMonitor::Clock::duration duration)
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(duration)
+            .count());
+}
+
+LoopMonitor::LoopMonitor(std::shared_ptr<boost::asio::io_context>& io,
+                         Clock::duration interval) :
+    timer(*io, "loopProbe"),
+    interval(interval)
+{
+    uint64_t watchdogUsec = 0;
+    if (sd_watchdog_enabled(0, &watchdogUsec) > 0 && watchdogUsec)
+    {
+        // ping twice per timeout so a single late ping does not trip it.
+        watchdogEnabled = true;
+        this->interval = std::min<Clock::duration>(
+            interval, std::chrono::microseconds(watchdogUsec / 2));
+        log::info(log::Category::APP, "Watchdog enabled, timeout ",
+                  watchdogUsec / 1000, " ms.");
+    }
+}
+
+void LoopMonitor::start()
+{
+    scheduleProbe();
+}
+
+void LoopMonitor::stop()
+{
+    timer.cancel();
+}
+
+void LoopMonitor::recordHandler(std::string_view name,
+                                Clock::duration duration)
+{
+    if (duration > slowestDuration)
+    {
+        slowestHandler = name;
+        slowestDuration = duration;
+    }
+
+    if (duration < slowHandlerThreshold)
+    {
+        return;
+    }
+
+    auto it = slowHandlers.find(name);
+    if (it == slowHandlers.end())
+    {
+        it = slowHandlers.emplace(std::string(name), std::make_tuple(0, 0))
+                 .first;
+    }
+
+    auto& [count, maxDuration] = it->second;
+    ++count;
+    maxDuration = std::max(maxDuration, toMicroseconds(duration));
+
+    log::warning(log::Category::APP, "Slow handler ", name, " took ",
+                 toMicroseconds(duration) / 1000, " ms.");
+}
+
+const LoopMonitor::SlowHandlers& LoopMonitor::getSlowHandlers()
+{
+    return slowHandlers;
+}
+
+void LoopMonitor::registerMethods(
+    std::shared_ptr<sdbusplus::asio::dbus_interface>& iface)
+{
+    iface->register_method("GetSlowHandlers",
+                           []() { return getSlowHandlers(); });
+}
+
+void LoopMonitor::scheduleProbe()
+{
+    timer.expiresAfter(interval, [this]() {
+        if (watchdogEnabled)
+        {
+            sd_notify(0, "WATCHDOG=1");
+        }
+
+        // from the tick the probe was due at, so the rounding of its expiry
+        // to the tick is not counted as lag.
+        const auto lag = Clock::now() - timer.getExpiry();
+        metrics::get().loopLag.observe(lag);
+        metrics::get().lastLoopLag.set(
+            static_cast<int64_t>(toMicroseconds(lag)));
+
+        if (lag >= slowHandlerThreshold)
+        {
+            log::warning(log::Category::APP, "Event loop lagged ",
+                         toMicroseconds(lag) / 1000, " ms. Slowest handler ",
+                         slowestHandler.empty() ? "unknown" : slowestHandler,
+                         " took ", toMicroseconds(slowestDuration) / 1000,
+                         " ms.");
+        }
+        slowestHandler = {};
+        slowestDuration = {};
+
+        scheduleProbe();
+    });
+}
+} // namespace panel
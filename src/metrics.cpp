@@ -0,0 +1,142 @@
+#include "metrics.hpp"
+
+#include <algorithm>
+
+namespace panel
+{
+namespace metrics
+{
+void Histogram::observe(uint64_t value)
+{
+    const auto bucket =
+        std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin();
+
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+
+    auto currentMax = max.load(std::memory_order_relaxed);
+    while (value > currentMax &&
+           !max.compare_exchange_weak(currentMax, value,
+                                      std::memory_order_relaxed))
+    {
+    }
+}
+
+HistogramSnapshot Histogram::getSnapshot() const
+{
+    std::vector<uint64_t> counts;
+    counts.reserve(buckets.size());
+    for (const auto& bucket : buckets)
+    {
+        counts.push_back(bucket.load(std::memory_order_relaxed));
+    }
+
+    return {std::move(counts), count.load(std::memory_order_relaxed),
+            sum.load(std::memory_order_relaxed),
+            max.load(std::memory_order_relaxed)};
+}
+
+Metrics& Metrics::getInstance()
+{
+    static Metrics metrics;
+    return metrics;
+}
+
+Histogram& Metrics::getDbusCallLatency(std::string_view service)
+{
+    auto findService = [this, service](size_t count) -> Histogram* {
+        for (size_t index = 0; index < count; ++index)
+        {
+            if (serviceLatency[index].service == service)
+            {
+                return &serviceLatency[index].latency;
+            }
+        }
+        return nullptr;
+    };
+
+    // services are only added, lookup of the added ones needs no lock.
+    if (auto latency =
+            findService(serviceCount.load(std::memory_order_acquire)))
+    {
+        return *latency;
+    }
+
+    std::lock_guard<std::mutex> lock(serviceMutex);
+
+    const auto count = serviceCount.load(std::memory_order_relaxed);
+    if (auto latency = findService(count))
+    {
+        return *latency;
+    }
+
+    if (count == maxServices)
+    {
+        return otherServicesLatency;
+    }
+
+    serviceLatency[count].service = service;
+    serviceCount.store(count + 1, std::memory_order_release);
+    return serviceLatency[count].latency;
+}
+
+std::map<std::string, uint64_t> Metrics::getCounters() const
+{
+    return {{"button_events", buttonEvents.get()},
+            {"frames_written", framesWritten.get()},
+            {"frames_suppressed", framesSuppressed.get()},
+            {"i2c_errors", i2cErrors.get()},
+            {"transport_recovery_attempts", transportRecoveryAttempts.get()},
+            {"transport_recoveries", transportRecoveries.get()},
+            {"pels_received", pelsReceived.get()},
+            {"progress_codes_received", progressCodesReceived.get()},
+            {"prefetches", prefetches.get()},
+            {"prefetch_hits", prefetchHits.get()},
+            {"prefetch_misses", prefetchMisses.get()},
+            {"functions_coalesced", functionsCoalesced.get()},
+            {"functions_rejected", functionsRejected.get()}};
+}
+
+std::map<std::string, int64_t> Metrics::getGauges() const
+{
+    return {{"loop_lag_last_us", lastLoopLag.get()},
+            {"command_queue_depth", commandQueueDepth.get()},
+            {"transports_down", transportsDown.get()}};
+}
+
+std::map<std::string, HistogramSnapshot> Metrics::getHistograms() const
+{
+    std::map<std::string, HistogramSnapshot> histograms{
+        {"loop_lag_us", loopLag.getSnapshot()},
+        {"command_wait_us", commandWait.getSnapshot()},
+        {"priority_dispatch_us", priorityDispatch.getSnapshot()},
+        {"panel_attach_us", panelAttach.getSnapshot()},
+        {"dbus_call_us:other", otherServicesLatency.getSnapshot()}};
+
+    const auto count = serviceCount.load(std::memory_order_acquire);
+    for (size_t index = 0; index < count; ++index)
+    {
+        histograms.emplace("dbus_call_us:" + serviceLatency[index].service,
+                           serviceLatency[index].latency.getSnapshot());
+    }
+    return histograms;
+}
+
+void Metrics::registerMethods(
+    std::shared_ptr<sdbusplus::asio::dbus_interface>& iface)
+{
+    iface->register_property(
+        "HistogramBucketBounds",
+        std::vector<uint64_t>(Histogram::bounds.begin(),
+                              Histogram::bounds.end()));
+
+    iface->register_method("GetCounters", [this]() { return getCounters(); });
+
+    iface->register_method("GetGauges", [this]() { return getGauges(); });
+
+    iface->register_method("GetHistograms",
+                           [this]() { return getHistograms(); });
+}
+} // namespace metrics
+} // namespace panel
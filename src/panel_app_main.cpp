@@ -2,41 +2,18 @@
 #include "bus_monitor.hpp"
 #include "button_handler.hpp"
 #include "const.hpp"
+#include "logger.hpp"
+#include "loop_monitor.hpp"
+#include "metrics.hpp"
+#include "platform.hpp"
+#include "timer_wheel.hpp"
 #include "utils.hpp"
 
+#include <cstdlib>
 #include <exception>
-#include <iostream>
 #include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/asio/object_server.hpp>
 
-panel::types::PanelDataMap baseDataMap = {
-    {panel::constants::rain2s2uIM,
-     {panel::constants::baseDevPath, panel::constants::devAddr,
-      panel::constants::rainBaseDbusObj}},
-    {panel::constants::rain2s4uIM,
-     {panel::constants::baseDevPath, panel::constants::devAddr,
-      panel::constants::rainBaseDbusObj}},
-    {panel::constants::rain1s4uIM,
-     {panel::constants::baseDevPath, panel::constants::devAddr,
-      panel::constants::rainBaseDbusObj}},
-    {panel::constants::everestIM,
-     {panel::constants::baseDevPath, panel::constants::devAddr,
-      panel::constants::everBaseDbusObj}}};
-
-panel::types::PanelDataMap lcdDataMap = {
-    {panel::constants::rain2s2uIM,
-     {panel::constants::rainLcdDevPath, panel::constants::devAddr,
-      panel::constants::rainLcdDbusObj}},
-    {panel::constants::rain2s4uIM,
-     {panel::constants::rainLcdDevPath, panel::constants::devAddr,
-      panel::constants::rainLcdDbusObj}},
-    {panel::constants::rain1s4uIM,
-     {panel::constants::rainLcdDevPath, panel::constants::devAddr,
-      panel::constants::rainLcdDbusObj}},
-    {panel::constants::everestIM,
-     {panel::constants::everLcdDevPath, panel::constants::devAddr,
-      panel::constants::everLcdDbusObj}}};
-
 std::string getIM()
 {
     auto im = panel::utils::readBusProperty<std::variant<panel::types::Binary>>(
@@ -48,33 +25,16 @@ std::string getIM()
     }
     else
     {
-        std::cerr << "\n Failed querying IM property from dbus" << std::endl;
+        panel::log::error(panel::log::Category::APP,
+                          "Failed querying IM property from dbus");
     }
     return "";
 }
 
-std::string getInputDevicePath(const std::string& imValue)
-{
-    if (imValue == panel::constants::rain2s2uIM ||
-        imValue == panel::constants::rain2s4uIM ||
-        imValue == panel::constants::rain1s4uIM)
-    {
-        return "/dev/input/by-path/platform-1e78a400.i2c-bus-event-joystick";
-    }
-    else if (imValue == panel::constants::everestIM)
-    {
-        return "/dev/input/by-path/platform-1e78a780.i2c-bus-event-joystick";
-    }
-
-    // default to tacoma
-    return "/dev/input/by-path/platform-1e78a080.i2c-bus-event-joystick";
-}
-
-bool getPresentProperty(const std::string& imValue)
+bool getPresentProperty(const std::string& objPath)
 {
     auto present = panel::utils::readBusProperty<std::variant<bool>>(
-        panel::constants::inventoryManagerIntf,
-        std::get<2>((lcdDataMap.find(imValue))->second),
+        panel::constants::inventoryManagerIntf, objPath,
         panel::constants::itemInterface, "Present");
     if (auto p = std::get_if<bool>(&present))
     {
@@ -82,34 +42,28 @@ bool getPresentProperty(const std::string& imValue)
     }
     else
     {
-        std::cerr << "\n Failed querying Present property from dbus."
-                  << std::endl;
+        panel::log::error(panel::log::Category::APP,
+                          "Failed querying Present property from dbus.");
     }
     return false;
 }
 
-void getLcdDeviceData(std::string& lcdDevPath, uint8_t& lcdDevAddr,
-                      std::string& lcdObjPath, const std::string& imValue)
-{
-    if (lcdDataMap.find(imValue) ==
-        lcdDataMap.end()) // assume the system is tacoma
-    {
-        lcdDevPath = panel::constants::tacomaLcdDevPath;
-        lcdDevAddr = panel::constants::devAddr;
-    }
-    else
-    {
-        lcdDevPath = std::get<0>((lcdDataMap.find(imValue))->second);
-        lcdDevAddr = std::get<1>((lcdDataMap.find(imValue))->second);
-        lcdObjPath = std::get<2>((lcdDataMap.find(imValue))->second);
-    }
-}
-
 int main(int, char**)
 {
     try
     {
         auto io = std::make_shared<boost::asio::io_context>();
+
+        // log entries are batched on the event loop.
+        panel::log::Logger::getInstance().attach(io);
+        if (const auto level = std::getenv("PANEL_LOG_LEVEL"))
+        {
+            if (const auto logLevel = panel::log::toLevel(level))
+            {
+                panel::log::Logger::getInstance().setLevel(*logLevel);
+            }
+        }
+
         auto conn = std::make_shared<sdbusplus::asio::connection>(*io);
         conn->request_name("com.ibm.PanelApp");
 
@@ -118,23 +72,19 @@ int main(int, char**)
         std::shared_ptr<sdbusplus::asio::dbus_interface> iface =
             server.add_interface("/com/ibm/panel_app", "com.ibm.panel");
 
-        const std::string imValue = getIM();
-
-        std::string lcdDevPath{}, lcdObjPath{};
-        uint8_t lcdDevAddr;
-        getLcdDeviceData(lcdDevPath, lcdDevAddr, lcdObjPath, imValue);
+        const auto& platform = panel::platform::findPlatform(getIM());
 
         // create transport lcd object
         auto lcdPanel = std::make_shared<panel::Transport>(
-            lcdDevPath, lcdDevAddr, panel::types::PanelType::LCD);
+            io, std::string(platform.lcd.devPath), platform.lcd.devAddr,
+            panel::types::PanelType::LCD);
 
         // create transport base object
         std::shared_ptr<panel::Transport> basePanel;
-        if (baseDataMap.find(imValue) != baseDataMap.end())
+        if (platform.base)
         {
             basePanel = std::make_shared<panel::Transport>(
-                std::get<0>((baseDataMap.find(imValue))->second),
-                std::get<1>((baseDataMap.find(imValue))->second),
+                io, std::string(platform.base->devPath), platform.base->devAddr,
                 panel::types::PanelType::BASE);
             basePanel->setTransportKey(true);
         }
@@ -142,7 +92,8 @@ int main(int, char**)
         // Listen to lcd panel presence always for both rainier and everest
         std::unique_ptr<panel::PanelPresence> presence;
 
-        if (lcdDataMap.find(imValue) != lcdDataMap.end())
+        std::string lcdObjPath(platform.lcd.dbusObj);
+        if (!lcdObjPath.empty())
         {
             presence = std::make_unique<panel::PanelPresence>(lcdObjPath, conn,
                                                               lcdPanel);
@@ -155,7 +106,7 @@ int main(int, char**)
              * change from false to true; but the transport key is still
              * true(unchanged). To maintain data accuracy get the "Present"
              * property from dbus and set the transport key again.*/
-            lcdPanel->setTransportKey(getPresentProperty(imValue));
+            lcdPanel->setTransportKey(getPresentProperty(lcdObjPath));
         }
         else
         {
@@ -163,13 +114,34 @@ int main(int, char**)
             lcdPanel->setTransportKey(true);
         }
 
+        // scroll the lines too long for the panel, and restore the display
+        // after a lamp test.
+        auto scroller = std::make_shared<panel::Scroller>(io, lcdPanel);
+        panel::utils::initDisplay(*io, scroller);
+
+        // create PLDM framework to send functions owned by PHYP.
+        auto pldm = std::make_shared<panel::PldmFramework>(io, conn);
+
+        // run the blocking calls of functions on worker threads, if enabled.
+        std::shared_ptr<panel::WorkerPool> workers;
+        if constexpr (panel::WorkerPool::isThreaded())
+        {
+            workers = std::make_shared<panel::WorkerPool>(io);
+        }
+
+        // host control functions write on a connection of their own, not
+        // behind the traffic of the other functions.
+        auto hostControlConn =
+            std::make_shared<sdbusplus::asio::connection>(*io);
+
         // create executor class
-        auto executor = std::make_shared<panel::Executor>(lcdPanel);
+        auto executor = std::make_shared<panel::Executor>(
+            lcdPanel, conn, pldm, workers, hostControlConn);
 
         // create state manager object
         auto stateManager =
             std::make_shared<panel::state::manager::PanelStateManager>(
-                lcdPanel, executor);
+                lcdPanel, executor, io);
 
         // TODO: via https://github.com/ibm-openbmc/ibm-panel/issues/21
         // Remove this try catch around the button handler once Everest device
@@ -178,35 +150,69 @@ int main(int, char**)
         try
         {
             btnHandler = std::make_unique<panel::ButtonHandler>(
-                getInputDevicePath(imValue), io, lcdPanel, stateManager);
+                std::string(platform.inputDevPath), io, lcdPanel,
+                stateManager);
         }
         catch (const std::runtime_error& e)
         {
-            std::cerr << e.what() << std::endl;
-            std::cerr << "Could not initialize button handler, panel buttons "
-                         "will not work!"
-                      << std::endl;
+            panel::log::error(panel::log::Category::APP, e.what());
+            panel::log::error(
+                panel::log::Category::APP,
+                "Could not initialize button handler, panel buttons will not "
+                "work!");
         }
 
         panel::PELListener pelEvent(conn, stateManager, executor);
         pelEvent.listenPelEvents();
 
+        // load the display of function 20, and reload it on VPD change.
+        panel::VpdListener vpdListener(conn, executor);
+        vpdListener.listenVpdChanges();
+        executor->loadVpdDisplay();
+
+        // drop the cached display of function 01 as its parameters change.
+        panel::SystemParameterListener parameterListener(conn, executor);
+        parameterListener.listenParameterChanges();
+
+        // create IPL timeline tracker and publish it on D-Bus.
+        auto iplTimeline = std::make_shared<panel::IplTimeline>();
+        std::shared_ptr<sdbusplus::asio::dbus_interface> timelineIface =
+            server.add_interface("/com/ibm/panel_app",
+                                 "com.ibm.panel.IPLTimeline");
+        iplTimeline->registerMethods(timelineIface);
+        timelineIface->initialize();
+
         // register property change call back for progress code.
-        panel::BootProgressCode progressCode(lcdPanel, conn, executor);
+        panel::BootProgressCode progressCode(lcdPanel, conn, executor,
+                                             iplTimeline);
         progressCode.listenProgressCode();
 
         panel::BusHandler busHandle(lcdPanel, iface, stateManager);
 
         iface->initialize();
 
+        // publish the metrics of the app on D-Bus.
+        std::shared_ptr<sdbusplus::asio::dbus_interface> metricsIface =
+            server.add_interface("/com/ibm/panel_app",
+                                 "com.ibm.panel.Metrics");
+        panel::metrics::get().registerMethods(metricsIface);
+        panel::LoopMonitor::registerMethods(metricsIface);
+        boost::asio::use_service<panel::TimerWheel>(*io).registerMethods(
+            metricsIface);
+        metricsIface->initialize();
+
+        // probe the event loop lag and ping the systemd watchdog.
+        panel::LoopMonitor loopMonitor(io);
+        loopMonitor.start();
+
         panel::SystemStatus systemStatus(conn, stateManager);
 
         io->run();
     }
     catch (const std::exception& e)
     {
-        std::cerr << e.what();
-        std::cerr << "Panel app exiting..." << std::endl;
+        panel::log::error(panel::log::Category::APP, e.what());
+        panel::log::error(panel::log::Category::APP, "Panel app exiting...");
         return 0;
         // TODO: Need to rethrow here so that systemd can mark the service a
         // failure. We will do that once Everest hardware is ready.
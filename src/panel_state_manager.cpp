@@ -1,5 +1,6 @@
 #include "panel_state_manager.hpp"
 
+#include "logger.hpp"
 #include "utils.hpp"
 
 #include <algorithm>
@@ -180,8 +181,8 @@ void PanelStateManager::enableFunctonality(
         }
         else
         {
-            std::cout << "Entry for function Number " << functionNumber
-                      << " not found" << std::endl;
+            log::warning(log::Category::STATE, "Entry for function Number ",
+                         functionNumber, " not found");
         }
     }
 }
@@ -208,8 +209,9 @@ void PanelStateManager::disableFunctonality(
         }
         else
         {
-            std::cout << "Entry for functionality Number " << functionNumber
-                      << " not found" << std::endl;
+            log::warning(log::Category::STATE,
+                         "Entry for functionality Number ", functionNumber,
+                         " not found");
         }
     }
 }
@@ -230,8 +232,8 @@ void PanelStateManager::toggleFuncStateFromPhyp(
         if (pos != list.end())
         {
             // then the cout can be used to test the function number.
-            std::cout << "Function to be enabled"
-                      << (int)aFunction.functionNumber << std::endl;
+            log::debug(log::Category::STATE, "Function to be enabled",
+                       (int)aFunction.functionNumber);
 
             aFunction.functionEnabledByPhyp = SystemStateMask::ENABLE_BY_PHYP;
         }
@@ -248,24 +250,21 @@ void PanelStateManager::toggleFuncStateFromPhyp(
 void PanelStateManager::printPanelStates()
 {
     const PanelFunctionality& funcState = panelFunctions.at(panelCurState);
-    std::cout << "Selected functionality = " << int(funcState.functionNumber)
-              << std::endl;
+    log::debug(log::Category::STATE, "Selected functionality = ",
+               int(funcState.functionNumber));
 
     if (funcState.functionNumber == FUNCTION_02 && isSubrangeActive)
     {
-        std::cout << "Active sub state level 0 = "
-                  << functionality02[0].at(panelCurSubStates.at(0))
-                  << std::endl;
+        log::debug(log::Category::STATE, "Active sub state level 0 = ",
+                   functionality02[0].at(panelCurSubStates.at(0)));
         if (panelCurSubStates.at(1) != StateType::INVALID_STATE)
         {
-            std::cout << "Active sub state level 1 = "
-                      << functionality02[1].at(panelCurSubStates.at(1))
-                      << std::endl;
+            log::debug(log::Category::STATE, "Active sub state level 1 = ",
+                       functionality02[1].at(panelCurSubStates.at(1)));
             if (panelCurSubStates.at(2) != StateType::INVALID_STATE)
             {
-                std::cout << "Active sub state level 2 = "
-                          << functionality02[2].at(panelCurSubStates.at(2))
-                          << std::endl;
+                log::debug(log::Category::STATE, "Active sub state level 2 = ",
+                           functionality02[2].at(panelCurSubStates.at(2)));
             }
         }
     }
@@ -275,16 +274,19 @@ void PanelStateManager::printPanelStates()
         {
             if (panelCurSubStates.at(0) == StateType::INITIAL_STATE)
             {
-                std::cout << "Active sub state level 0 = INITIAL" << std::endl;
+                log::debug(log::Category::STATE,
+                           "Active sub state level 0 = INITIAL");
             }
             else if (panelCurSubStates.at(0) == StateType::STAR_STATE)
             {
-                std::cout << "Active sub state level 0 = **" << std::endl;
+                log::debug(log::Category::STATE,
+                           "Active sub state level 0 = **");
             }
             else
             {
-                std::cout << "Current active sub state level 0 = "
-                          << int(panelCurSubStates.at(0)) << std::endl;
+                log::debug(log::Category::STATE,
+                           "Current active sub state level 0 = ",
+                           int(panelCurSubStates.at(0)));
             }
         }
     }
@@ -293,6 +295,18 @@ void PanelStateManager::printPanelStates()
 void PanelStateManager::processPanelButtonEvent(
     const types::ButtonEvent& button)
 {
+    if (inactivityTimer)
+    {
+        inactivityTimer->expiresAfter(inactivityTimeout,
+                                      [this]() { returnToFunction01(); });
+    }
+
+    // the debounce SRC is confirmed, or moved away from, by any button.
+    if (debounceTimer)
+    {
+        debounceTimer->cancel();
+    }
+
     // In case panel is in DEBOUCNE_SRC_STATE, and next button is increment
     // or decrement, it should come out of DEBOUCNE_SRC_STATE
     if (panelCurSubStates.at(0) == StateType::DEBOUCNE_SRC_STATE &&
@@ -305,10 +319,13 @@ void PanelStateManager::processPanelButtonEvent(
     switch (button)
     {
         case types::ButtonEvent::INCREMENT:
+            // user moved away from the function being executed.
+            funcExecutor->cancelExecution();
             incrementState();
             break;
 
         case types::ButtonEvent::DECREMENT:
+            funcExecutor->cancelExecution();
             decrementState();
             break;
 
@@ -345,6 +362,27 @@ void PanelStateManager::initPanelState()
     panelCurSubStates.push_back(StateType::INVALID_STATE);
 }
 
+void PanelStateManager::returnToFunction01()
+{
+    if (panelCurState == StateType::INITIAL_STATE &&
+        panelCurSubStates.at(0) == StateType::INITIAL_STATE)
+    {
+        return;
+    }
+
+    log::info(log::Category::STATE,
+              "No button event, panel returned to function 01.");
+
+    funcExecutor->cancelExecution();
+    panelCurState = StateType::INITIAL_STATE;
+    panelCurSubStates.at(0) = StateType::INITIAL_STATE;
+    panelCurSubStates.at(1) = StateType::INVALID_STATE;
+    panelCurSubStates.at(2) = StateType::INVALID_STATE;
+    isSubrangeActive = false;
+    levelToOperate = 0;
+    createDisplayString();
+}
+
 std::tuple<types::FunctionNumber, types::FunctionNumber>
     PanelStateManager::getPanelCurrentStateInfo() const
 {
@@ -385,7 +423,7 @@ void PanelStateManager::initFunction02()
         else
         {
             // TODO: Add elog here to detect invalid mode.
-            std::cout << "Invalid Mode" << std::endl;
+            log::warning(log::Category::STATE, "Invalid Mode");
         }
 
         const auto& systemOperatingMode = std::get<1>(sysValues);
@@ -409,7 +447,7 @@ void PanelStateManager::initFunction02()
     }
     catch (const std::exception& e)
     {
-        std::cout << e.what() << std::endl;
+        log::error(log::Category::STATE, e.what());
         // TODO: Display FF once that commit is in.
     }
 }
@@ -569,6 +607,9 @@ void PanelStateManager::incrementState()
 
             panelCurState = distance(panelFunctions.begin(), pos);
         }
+
+        // start reading the data of the function the user moved to.
+        funcExecutor->prefetch(panelFunctions.at(panelCurState).functionNumber);
     }
     createDisplayString();
 }
@@ -634,6 +675,9 @@ void PanelStateManager::decrementState()
 
             panelCurState = distance(nextpos, (panelFunctions.rend() - 1));
         }
+
+        // start reading the data of the function the user moved to.
+        funcExecutor->prefetch(panelFunctions.at(panelCurState).functionNumber);
     }
     createDisplayString();
 }
@@ -653,6 +697,15 @@ void PanelStateManager::executeState()
     {
         panelCurSubStates.at(0) = StateType::DEBOUCNE_SRC_STATE;
         displayDebounce();
+
+        // the function is not run if not confirmed in the window.
+        if (debounceTimer)
+        {
+            debounceTimer->expiresAfter(debounceWindow, [this]() {
+                panelCurSubStates.at(0) = StateType::INITIAL_STATE;
+                createDisplayString();
+            });
+        }
         return;
     }
 
@@ -677,15 +730,15 @@ void PanelStateManager::executeState()
                 isSubrangeActive = false;
                 panelCurSubStates.at(0) = StateType::INITIAL_STATE;
                 createDisplayString();
-                std::cout << "Exit sub range, retain state at " << panelCurState
-                          << std::endl;
+                log::debug(log::Category::STATE,
+                           "Exit sub range, retain state at ", panelCurState);
             }
             else
             {
-                std::cout << "Subrange is already active, execute the sub "
-                             "functionality "
-                          << panelCurSubStates.at(0) << " of functionality"
-                          << panelCurState << std::endl;
+                log::debug(log::Category::STATE,
+                           "Subrange is already active, execute the sub "
+                           "functionality ", panelCurSubStates.at(0),
+                           " of functionality", panelCurState);
 
                 // after this execute do whatever is required to execute the
                 // functionality
@@ -732,10 +785,10 @@ void PanelStateManager::executeState()
             panelCurSubStates.at(0) = StateType::STAR_STATE;
             createDisplayString();
 
-            std::cout << "Sub Range has been activated, execute the sub "
-                         "functionality "
-                      << panelCurSubStates.at(0) << " of functionality"
-                      << panelCurState << std::endl;
+            log::debug(log::Category::STATE,
+                       "Sub Range has been activated, execute the sub "
+                       "functionality ", panelCurSubStates.at(0),
+                       " of functionality", panelCurState);
 
             // after this execute do whatever is required to execute the
             // functionality
@@ -745,7 +798,7 @@ void PanelStateManager::executeState()
     {
         // set this anyhow in case we are coming from debounce SRC state.
         panelCurSubStates.at(0) = StateType::INITIAL_STATE;
-        std::cout << "Execute method" << std::endl;
+        log::debug(log::Category::STATE, "Execute method");
 
         funcExecutor->executeFunction(
             panelFunctions.at(panelCurState).functionNumber, panelCurSubStates);
@@ -855,10 +908,10 @@ void PanelStateManager::updateFunctionStatus()
     }
 }
 
-void PanelStateManager::updateBMCState(const std::string& bmcState)
+void PanelStateManager::updateBMCState(types::BMCState bmcState)
 {
     // BMC state is anything other than NotReady
-    if (bmcState != "xyz.openbmc_project.State.BMC.BMCState.NotReady")
+    if (bmcState != types::BMCState::NOT_READY)
     {
         // if the bit is not set
         if ((systemState & SystemStateMask::ENABLE_BMC_STANDBY_STATE) == 0x00)
@@ -870,9 +923,8 @@ void PanelStateManager::updateBMCState(const std::string& bmcState)
         }
     }
     // if the bit is already set and BMC state is NotReady
-    else if ((bmcState == "xyz.openbmc_project.State.BMC.BMCState.NotReady") &&
-             ((systemState & SystemStateMask::ENABLE_BMC_STANDBY_STATE) ==
-              SystemStateMask::ENABLE_BMC_STANDBY_STATE))
+    else if ((systemState & SystemStateMask::ENABLE_BMC_STANDBY_STATE) ==
+             SystemStateMask::ENABLE_BMC_STANDBY_STATE)
     {
         // if the bit is set unset the bit
         systemState &= SystemStateMask::DISABLE_BMC_STANDBY_STATE;
@@ -880,9 +932,9 @@ void PanelStateManager::updateBMCState(const std::string& bmcState)
     }
 }
 
-void PanelStateManager::updatePowerState(const std::string& powerState)
+void PanelStateManager::updatePowerState(types::PowerState powerState)
 {
-    if (powerState == "xyz.openbmc_project.State.Chassis.PowerState.On")
+    if (powerState == types::PowerState::ON)
     {
         // if the bit is not set
         if ((systemState & SystemStateMask::ENABLE_POWER_STATE) ==
@@ -895,8 +947,7 @@ void PanelStateManager::updatePowerState(const std::string& powerState)
         }
     }
     // if the bit is already set and state is off
-    else if ((powerState ==
-              "xyz.openbmc_project.State.Chassis.PowerState.Off") &&
+    else if ((powerState == types::PowerState::OFF) &&
              ((systemState & SystemStateMask::ENABLE_POWER_STATE) ==
               SystemStateMask::ENABLE_POWER_STATE))
     {
@@ -906,11 +957,10 @@ void PanelStateManager::updatePowerState(const std::string& powerState)
     }
 }
 
-void PanelStateManager::updateBootProgressState(const std::string& bootState)
+void PanelStateManager::updateBootProgressState(types::BootProgress bootState)
 {
     // Phyp running.
-    if (bootState ==
-        "xyz.openbmc_project.State.Boot.Progress.ProgressStages.OSRunning")
+    if (bootState == types::BootProgress::OS_RUNNING)
     {
         // if the bit is not set
         if ((systemState & SystemStateMask::ENABLE_PHYP_RUNTIME_STATE) == 0x00)
@@ -931,9 +981,10 @@ void PanelStateManager::updateBootProgressState(const std::string& bootState)
     }
 }
 
-void PanelStateManager::setSystemOperatingMode(const std::string& operatingMode)
+void PanelStateManager::setSystemOperatingMode(
+    types::OperatingMode operatingMode)
 {
-    if (operatingMode == "Manual")
+    if (operatingMode == types::OperatingMode::MANUAL)
     {
         // Check if the bit is already not set
         if ((systemState & SystemStateMask::ENABLE_MANUAL_MODE) == 0x00)
@@ -1,181 +1,535 @@
 #include "pldm_fw.hpp"
 
+#include "async_utils.hpp"
 #include "exception.hpp"
+#include "logger.hpp"
+#include "loop_monitor.hpp"
+#include "metrics.hpp"
 
 #include <libpldm/entity.h>
 #include <libpldm/platform.h>
 #include <libpldm/pldm.h>
 #include <libpldm/state_set.h>
 
-#include <iostream>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <optional>
 #include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/asio/object_server.hpp>
+#include <string>
+#include <variant>
 
 namespace panel
 {
+/* PLDM daemon service */
+static constexpr auto pldmService = "xyz.openbmc_project.PLDM";
 
-PdrList PldmFramework::getPDR(const uint8_t& terminusId,
-                              const uint16_t& entityId,
-                              const uint16_t& stateSetId,
-                              const std::string& pdrMethod)
+PldmFramework::PldmFramework(
+    std::shared_ptr<boost::asio::io_context>& io,
+    std::shared_ptr<sdbusplus::asio::connection> conn,
+    MctpSocketOpener socketOpener) :
+    io(io), socketOpener(socketOpener), conn(conn)
+{
+    // pldmd builds its PDR repository afresh when it restarts.
+    pldmOwnerMatch = std::make_unique<sdbusplus::bus::match::match>(
+        *conn, sdbusplus::bus::match::rules::nameOwnerChanged(pldmService),
+        [this](sdbusplus::message::message&) {
+            log::info(log::Category::PLDM,
+                      "pldm: pldmd owner changed, invalidating PDR cache");
+            invalidatePdrCache();
+
+            // ids held by the old pldmd could be given out again.
+            spareInstanceIds.clear();
+        });
+
+    // Host sends its PDRs to pldmd afresh on every IPL, and pldmd replaces the
+    // host PDRs in its repository with them.
+    hostProgressMatch = std::make_unique<sdbusplus::bus::match::match>(
+        *conn,
+        sdbusplus::bus::match::rules::propertiesChanged(
+            "/xyz/openbmc_project/state/host0",
+            "xyz.openbmc_project.State.Boot.Progress"),
+        [this](sdbusplus::message::message& msg) {
+            std::string interface{};
+            std::map<std::string, std::variant<std::string>> properties;
+            msg.read(interface, properties);
+
+            const auto itr = properties.find("BootProgress");
+            if (itr == properties.end())
+            {
+                return;
+            }
+
+            const auto progress = types::bootProgressParser.parse(
+                std::get<std::string>(itr->second));
+            if (isPdrRepublished(hostProgress, progress))
+            {
+                log::info(log::Category::PLDM,
+                          "pldm: host PDRs republished, invalidating PDR "
+                          "cache");
+                invalidatePdrCache();
+            }
+            hostProgress = progress;
+        });
+}
+
+bool PldmFramework::isPdrRepublished(types::BootProgress from,
+                                     types::BootProgress to)
+{
+    if (from == to)
+    {
+        return false;
+    }
+
+    // progress is unspecified while the host is off or being reset.
+    return from == types::BootProgress::OS_RUNNING ||
+           to == types::BootProgress::OS_RUNNING ||
+           to == types::BootProgress::UNSPECIFIED;
+}
+
+boost::asio::awaitable<PdrList>
+    PldmFramework::getPDR(uint8_t terminusId, uint16_t entityId,
+                          uint16_t stateSetId, std::string pdrMethod)
 {
-    PdrList pdrs{};
     try
     {
-        auto bus = sdbusplus::bus::new_default();
-        auto method = bus.new_method_call(
-            "xyz.openbmc_project.PLDM", "/xyz/openbmc_project/pldm",
-            "xyz.openbmc_project.PLDM.PDR", pdrMethod.c_str());
-        method.append(terminusId, entityId, stateSetId);
-        auto responseMsg = bus.call(method);
-        responseMsg.read(pdrs);
+        co_return co_await utils::asyncMethodCall<PdrList>(
+            *conn, pldmService, "/xyz/openbmc_project/pldm",
+            "xyz.openbmc_project.PLDM.PDR", std::move(pdrMethod), terminusId,
+            entityId, stateSetId);
     }
-    catch (const sdbusplus::exception::SdBusError& e)
+    catch (const boost::system::system_error& e)
     {
-        std::cerr << e.what() << std::endl;
-        throw FunctionFailure("pldm: Failed to fetch the PDR.");
+        log::error(log::Category::PLDM, e.what());
     }
-    return pdrs;
+    throw FunctionFailure("pldm: Failed to fetch the PDR.");
 }
 
-types::Byte PldmFramework::getInstanceID()
+boost::asio::awaitable<types::Byte> PldmFramework::getInstanceID()
 {
-    types::Byte instanceId = 0;
-    auto bus = sdbusplus::bus::new_default();
+    if (!spareInstanceIds.empty())
+    {
+        const auto instance = spareInstanceIds.back();
+        spareInstanceIds.pop_back();
+        co_return instance;
+    }
 
     try
     {
-        auto method = bus.new_method_call(
-            "xyz.openbmc_project.PLDM", "/xyz/openbmc_project/pldm",
-            "xyz.openbmc_project.PLDM.Requester", "GetInstanceId");
-        method.append(mctpEid);
-        auto reply = bus.call(method);
-        reply.read(instanceId);
+        co_return co_await utils::asyncMethodCall<types::Byte>(
+            *conn, pldmService, "/xyz/openbmc_project/pldm",
+            "xyz.openbmc_project.PLDM.Requester", "GetInstanceId", mctpEid);
     }
-    catch (const sdbusplus::exception::SdBusError& e)
+    catch (const boost::system::system_error& e)
     {
-        std::cerr << e.what() << std::endl;
-        throw FunctionFailure("pldm: call to GetInstanceId failed.");
+        log::error(log::Category::PLDM, e.what());
     }
-    return instanceId;
+    throw FunctionFailure("pldm: call to GetInstanceId failed.");
 }
 
-void PldmFramework::fetchPanelEffecterStateSet(const PdrList& pdrs,
-                                               uint16_t& effecterId,
-                                               types::Byte& effecterCount,
-                                               types::Byte& panelEffecterPos)
+PldmFramework::PanelEffecterInfo
+    PldmFramework::parsePanelEffecterPdr(const types::PldmPacket& pdr)
 {
-    auto pdr =
-        reinterpret_cast<const pldm_state_effecter_pdr*>(pdrs.front().data());
+    const size_t statesOffset =
+        offsetof(pldm_state_effecter_pdr, possible_states);
+
+    if (pdr.size() < statesOffset)
+    {
+        throw FunctionFailure("pldm: Panel effecter PDR is too short.");
+    }
+
+    auto effecterPdr =
+        reinterpret_cast<const pldm_state_effecter_pdr*>(pdr.data());
 
-    auto possibleStates =
-        reinterpret_cast<const state_effecter_possible_states*>(
-            pdr->possible_states);
+    PanelEffecterInfo effecterInfo;
+    effecterInfo.effecterId = effecterPdr->effecter_id;
+    effecterInfo.effecterCount = effecterPdr->composite_effecter_count;
 
-    for (auto offset = 0; offset < pdr->composite_effecter_count; offset++)
+    if (effecterInfo.effecterCount == 0 ||
+        effecterInfo.effecterCount > maxCompositeEffecters)
     {
-        if (possibleStates->state_set_id == stateIdToEnablePanelFunc)
+        throw FunctionFailure(
+            "pldm: Invalid composite effecter count in panel effecter PDR.");
+    }
+
+    // state set id and possible states size, preceding the possible states.
+    constexpr size_t possibleStatesHdrSize =
+        offsetof(state_effecter_possible_states, states);
+
+    bool found = false;
+    size_t offset = statesOffset;
+    for (types::Byte pos = 0; pos < effecterInfo.effecterCount; pos++)
+    {
+        if (offset + possibleStatesHdrSize > pdr.size())
         {
-            effecterId = pdr->effecter_id;
-            effecterCount = pdr->composite_effecter_count;
-            panelEffecterPos = offset;
-            return;
+            throw FunctionFailure("pldm: Panel effecter PDR is truncated.");
+        }
+
+        auto possibleStates =
+            reinterpret_cast<const state_effecter_possible_states*>(
+                pdr.data() + offset);
+
+        if (!found && possibleStates->state_set_id == stateIdToEnablePanelFunc)
+        {
+            effecterInfo.panelEffecterPos = pos;
+            found = true;
+        }
+
+        offset += possibleStatesHdrSize + possibleStates->possible_states_size;
+        if (offset > pdr.size())
+        {
+            throw FunctionFailure("pldm: Panel effecter PDR is truncated.");
         }
     }
 
-    throw FunctionFailure(
-        "State set ID to enable panel function could not be found in PDR.");
+    if (!found)
+    {
+        throw FunctionFailure(
+            "State set ID to enable panel function could not be found in PDR.");
+    }
+
+    buildSetEffecterReqTemplate(effecterInfo);
+    return effecterInfo;
 }
 
-types::PldmPacket
-    PldmFramework::prepareSetEffecterReq(const PdrList& pdrs,
-                                         types::Byte instanceId,
-                                         const types::FunctionNumber& function)
+void PldmFramework::buildSetEffecterReqTemplate(
+    PanelEffecterInfo& effecterInfo)
 {
-    types::Byte effecterCount = 0;
-    types::Byte panelEffecterPos = 0;
-    uint16_t effecterId = 0;
+    std::array<set_effecter_state_field, maxCompositeEffecters> stateFields{};
+    for (auto& stateField : stateFields)
+    {
+        stateField = set_effecter_state_field{PLDM_NO_CHANGE, 0};
+    }
+    stateFields[effecterInfo.panelEffecterPos] =
+        set_effecter_state_field{PLDM_REQUEST_SET, 0};
 
-    fetchPanelEffecterStateSet(pdrs, effecterId, effecterCount,
-                               panelEffecterPos);
+    int rc = encode_set_state_effecter_states_req(
+        0, effecterInfo.effecterId, effecterInfo.effecterCount,
+        stateFields.data(),
+        reinterpret_cast<pldm_msg*>(effecterInfo.requestTemplate.data()));
 
-    types::PldmPacket request(
-        sizeof(pldm_msg_hdr) + sizeof(effecterId) + sizeof(effecterCount) +
-        (effecterCount * sizeof(set_effecter_state_field)));
+    if (rc != PLDM_SUCCESS)
+    {
+        log::error(log::Category::PLDM, "Return code = ", rc);
+        throw FunctionFailure(
+            "pldm: encode set effecter states request returned error.");
+    }
 
-    auto requestMsg = reinterpret_cast<pldm_msg*>(request.data());
+    // header, effecter id, effecter count and the state fields.
+    const size_t stateFieldsOffset =
+        sizeof(pldm_msg_hdr) + sizeof(effecterInfo.effecterId) +
+        sizeof(effecterInfo.effecterCount);
 
-    std::vector<set_effecter_state_field> stateField;
+    effecterInfo.requestSize =
+        stateFieldsOffset +
+        effecterInfo.effecterCount * sizeof(set_effecter_state_field);
 
-    for (types::Byte pos = 0; panelEffecterPos <= effecterCount; pos++)
+    effecterInfo.functionOffset =
+        stateFieldsOffset +
+        effecterInfo.panelEffecterPos * sizeof(set_effecter_state_field) +
+        offsetof(set_effecter_state_field, effecter_state);
+}
+
+boost::asio::awaitable<PldmFramework::PanelEffecterInfo>
+    PldmFramework::getPanelEffecterInfo()
+{
+    const PdrCacheKey key{phypTerminusID, frontPanelBoardEntityId,
+                          stateIdToEnablePanelFunc};
+
+    while (pdrFetched)
     {
-        if (pos == panelEffecterPos)
+        // PDR is being fetched for another request, wait for it.
+        auto fetched = pdrFetched;
+        try
         {
-            stateField.emplace_back(
-                set_effecter_state_field{PLDM_REQUEST_SET, function});
-            break;
+            co_await fetched->async_wait(boost::asio::use_awaitable);
         }
-        else
+        catch (const boost::system::system_error&)
         {
-            stateField.emplace_back(
-                set_effecter_state_field{PLDM_NO_CHANGE, 0});
+            // cancelled once the fetch completes.
         }
     }
 
-    int rc = encode_set_state_effecter_states_req(
-        instanceId, effecterId, effecterCount, stateField.data(), requestMsg);
+    if (auto itr = effecterCache.find(key); itr != effecterCache.end())
+    {
+        co_return itr->second;
+    }
 
-    if (rc != PLDM_SUCCESS)
+    // the fetch of another request failed, or the cache was invalidated.
+    const auto generation = cacheGeneration;
+    auto fetched = std::make_shared<boost::asio::steady_timer>(
+        *io, boost::asio::steady_timer::time_point::max());
+    pdrFetched = fetched;
+
+    std::exception_ptr error;
+    PanelEffecterInfo effecterInfo;
+    try
     {
-        std::cerr << "Return code = " << rc << std::endl;
-        throw FunctionFailure(
-            "pldm: encode set effecter states request returned error.");
+        PdrList pdrs =
+            co_await getPDR(phypTerminusID, frontPanelBoardEntityId,
+                            stateIdToEnablePanelFunc, "FindStateEffecterPDR");
+        if (pdrs.empty())
+        {
+            throw FunctionFailure("Empty PDR returned for panel entity id.");
+        }
+        effecterInfo = parsePanelEffecterPdr(pdrs.front());
+    }
+    catch (...)
+    {
+        error = std::current_exception();
     }
+
+    // PDR fetched before an invalidation is not cached.
+    if (!error && generation == cacheGeneration)
+    {
+        effecterCache.emplace(key, effecterInfo);
+    }
+
+    // wake up the requests waiting for this fetch.
+    fetched->cancel();
+    if (pdrFetched == fetched)
+    {
+        pdrFetched.reset();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+    co_return effecterInfo;
+}
+
+PldmFramework::SetEffecterRequest PldmFramework::prepareSetEffecterReq(
+    const PanelEffecterInfo& effecterInfo, types::Byte instanceId,
+    const types::FunctionNumber& function)
+{
+    SetEffecterRequest request = effecterInfo.requestTemplate;
+
+    reinterpret_cast<pldm_msg_hdr*>(request.data())->instance_id = instanceId;
+    request[effecterInfo.functionOffset] = function;
+
     return request;
 }
 
-void PldmFramework::sendPanelFunctionToPhyp(
-    const types::FunctionNumber& funcNumber)
+void PldmFramework::openMctpSocket()
 {
-    PdrList pdrs = getPDR(phypTerminusID, frontPanelBoardEntityId,
-                          stateIdToEnablePanelFunc, "FindStateEffecterPDR");
+    int fd = socketOpener ? socketOpener() : pldm_open();
+    if (fd == -1)
+    {
+        log::error(log::Category::PLDM,
+                   "Opening MCTP socket failed with error = ", strerror(errno));
+        throw FunctionFailure("pldm: Failed to connect to MCTP socket");
+    }
+
+    mctpSocket =
+        std::make_unique<boost::asio::posix::stream_descriptor>(*io, fd);
+    waitForResponse();
+}
 
-    if (pdrs.empty())
+void PldmFramework::closeMctpSocket()
+{
+    // closes the file descriptor as well.
+    mctpSocket.reset();
+
+    auto requests = std::move(pendingRequests);
+    pendingRequests.clear();
+
+    for (auto& [instanceId, request] : requests)
     {
-        throw FunctionFailure("Empty PDR returned for panel entity id.");
+        log::error(log::Category::PLDM,
+                   "pldm: MCTP socket closed, panel function ",
+                   static_cast<int>(request.function), " failed.");
+        request.handler(PldmStatus::TRANSPORT_ERROR, PLDM_ERROR);
     }
+}
 
-    types::Byte instance = getInstanceID();
+void PldmFramework::waitForResponse()
+{
+    mctpSocket->async_wait(
+        boost::asio::posix::stream_descriptor::wait_read,
+        [this](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                // aborted when the socket is closed.
+                if (ec != boost::asio::error::operation_aborted)
+                {
+                    log::error(log::Category::PLDM,
+                               "pldm: Wait on MCTP socket failed. ",
+                               ec.message());
+                    closeMctpSocket();
+                }
+                return;
+            }
+            LoopMonitor::HandlerScope scope("processResponse");
+            processResponse();
+        });
+}
+
+void PldmFramework::processResponse()
+{
+    uint8_t* response = nullptr;
+    size_t responseLength = 0;
 
-    types::PldmPacket packet =
-        prepareSetEffecterReq(pdrs, instance, funcNumber);
+    auto rc = pldm_recv_any(mctpEid, mctpSocket->native_handle(), &response,
+                            &responseLength);
 
-    if (packet.empty())
+    if (rc == PLDM_REQUESTER_RECV_FAIL)
     {
-        throw FunctionFailure(
-            "pldm:SetStateEffecterStates request message empty");
+        log::error(log::Category::PLDM, "pldm: Receive on MCTP socket failed.");
+        closeMctpSocket();
+        return;
     }
 
-    int fd = pldm_open();
-    if (fd == -1)
+    // Other failures are for messages not meant for us, e.g. requests from
+    // host or messages from other endpoints. Such messages are dropped.
+    if (rc == PLDM_REQUESTER_SUCCESS)
     {
-        std::cerr << "pldm_open() failed with error = " << strerror(errno)
-                  << std::endl;
-        throw FunctionFailure("pldm: Failed to connect to MCTP socket");
+        std::unique_ptr<uint8_t, decltype(&free)> responsePtr(response, free);
+        auto responseMsg = reinterpret_cast<const pldm_msg*>(response);
+
+        if (responseMsg->hdr.type == PLDM_PLATFORM &&
+            responseMsg->hdr.command == PLDM_SET_STATE_EFFECTER_STATES)
+        {
+            types::Byte completionCode = PLDM_ERROR;
+            if (decode_set_state_effecter_states_resp(
+                    responseMsg, responseLength - sizeof(pldm_msg_hdr),
+                    &completionCode) != PLDM_SUCCESS)
+            {
+                completionCode = PLDM_ERROR_INVALID_LENGTH;
+            }
+
+            completeRequest(responseMsg->hdr.instance_id,
+                            (completionCode == PLDM_SUCCESS)
+                                ? PldmStatus::SUCCESS
+                                : PldmStatus::COMPLETION_ERROR,
+                            completionCode);
+        }
+    }
+
+    // completion handler could have closed the socket.
+    if (mctpSocket)
+    {
+        waitForResponse();
+    }
+}
+
+void PldmFramework::completeRequest(types::Byte instanceId, PldmStatus status,
+                                    types::Byte completionCode)
+{
+    auto itr = pendingRequests.find(instanceId);
+    if (itr == pendingRequests.end())
+    {
+        // Response to a request of another requester, or to a request that
+        // has already timed out.
+        return;
     }
 
-    auto rc = pldm_send(mctpEid, fd, packet.data(), packet.size());
+    // Remove the request before calling the handler, as the handler can send
+    // another request.
+    auto request = std::move(itr->second);
+    pendingRequests.erase(itr);
 
-    if (close(fd) == -1)
+    const auto latency = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - request.sentAt);
+
+    if (status == PldmStatus::SUCCESS)
     {
-        std::cerr << "Close on File descriptor failed with error = "
-                  << strerror(errno) << std::endl;
+        log::debug(log::Category::PLDM, "pldm: Panel function ",
+                   static_cast<int>(request.function), " completed in ",
+                   latency.count(), " ms");
     }
+    else
+    {
+        log::error(log::Category::PLDM, "pldm: Panel function ",
+                   static_cast<int>(request.function), " failed. Status = ",
+                   static_cast<int>(status), ", completion code = ",
+                   static_cast<int>(completionCode), ", after ",
+                   latency.count(), " ms");
+    }
+
+    request.handler(status, completionCode);
+}
 
+void PldmFramework::sendPanelFunctionToPhyp(
+    const types::FunctionNumber& funcNumber, PldmResponseHandler handler)
+{
+    boost::asio::co_spawn(*io, sendRequest(funcNumber, std::move(handler)),
+                          boost::asio::detached);
+}
+
+boost::asio::awaitable<void>
+    PldmFramework::sendRequest(types::FunctionNumber funcNumber,
+                               PldmResponseHandler handler)
+{
+    std::optional<types::Byte> allocated;
+    PanelEffecterInfo effecterInfo;
+    try
+    {
+        effecterInfo = co_await getPanelEffecterInfo();
+        allocated = co_await getInstanceID();
+
+        if (!mctpSocket)
+        {
+            openMctpSocket();
+        }
+    }
+    catch (const FunctionFailure& e)
+    {
+        // an id not put on the wire is never freed by a response.
+        if (allocated)
+        {
+            spareInstanceIds.push_back(*allocated);
+        }
+
+        log::error(log::Category::PLDM, e.what(), " Panel function ",
+                   static_cast<int>(funcNumber), " not sent.");
+        handler(PldmStatus::REQUEST_ERROR, PLDM_ERROR);
+        co_return;
+    }
+
+    const auto instance = *allocated;
+    const auto request =
+        prepareSetEffecterReq(effecterInfo, instance, funcNumber);
+
+    auto rc = pldm_send(mctpEid, mctpSocket->native_handle(), request.data(),
+                        effecterInfo.requestSize);
     if (rc)
     {
-        throw FunctionFailure(
-            "pldm: pldm_send failed for panel function trigger.");
+        log::error(log::Category::PLDM,
+                   "pldm: pldm_send failed for panel function ",
+                   static_cast<int>(funcNumber));
+
+        // Socket is re-opened on next request.
+        closeMctpSocket();
+        spareInstanceIds.push_back(instance);
+        handler(PldmStatus::TRANSPORT_ERROR, PLDM_ERROR);
+        co_return;
     }
+
+    // A request still waiting on a recycled instance id is stale.
+    completeRequest(instance, PldmStatus::TIMEOUT, PLDM_ERROR);
+
+    const auto sequence = ++lastSequence;
+    auto timer = std::make_unique<TimerWheel::Timer>(*io, "requestTimeout");
+    timer->expiresAfter(responseTimeout, [this, instance, sequence]() {
+        // cancelled when the request completes before timeout, but only
+        // the request it was started for is timed out.
+        const auto itr = pendingRequests.find(instance);
+        if (itr != pendingRequests.end() && itr->second.sequence == sequence)
+        {
+            completeRequest(instance, PldmStatus::TIMEOUT, PLDM_ERROR);
+        }
+    });
+
+    pendingRequests.emplace(
+        instance,
+        PendingRequest{funcNumber, std::move(handler), std::move(timer),
+                       std::chrono::steady_clock::now(), sequence});
 }
 } // namespace panel
@@ -0,0 +1,92 @@
+#include "progress_code_decoder.hpp"
+
+#include <bit>
+#include <cstring>
+
+namespace panel
+{
+namespace decoder
+{
+/* Offset of hex word 2 in the secondary data, i.e. size of the SRC header. */
+static constexpr size_t hexWordOffset = 8;
+
+/* Size of a hex word in the secondary data. */
+static constexpr size_t hexWordSize = 4;
+
+/**
+ * @brief Store a 64 bit value so that its most significant byte comes first.
+ * @param[in] value - Value to be stored.
+ * @param[out] dest - Destination of 8 bytes.
+ */
+static inline void storeBigEndian(uint64_t value, char* dest)
+{
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        value = __builtin_bswap64(value);
+    }
+    std::memcpy(dest, &value, sizeof(value));
+}
+
+/**
+ * @brief Convert a big endian 4 byte hex word to 8 ASCII hex characters.
+ *
+ * All the 8 nibbles are converted in parallel within a 64 bit register instead
+ * of a character at a time.
+ *
+ * @param[in] src - Pointer to 4 bytes of hex word.
+ * @param[out] dest - Destination of 8 ASCII characters.
+ */
+static inline void hexWordToAscii(const types::Byte* src, char* dest)
+{
+    uint64_t nibbles = (static_cast<uint64_t>(src[0]) << 24) |
+                       (static_cast<uint64_t>(src[1]) << 16) |
+                       (static_cast<uint64_t>(src[2]) << 8) |
+                       static_cast<uint64_t>(src[3]);
+
+    // Spread the 8 nibbles so that each of them occupies one byte, most
+    // significant nibble in the most significant byte.
+    nibbles = (nibbles | (nibbles << 16)) & 0x0000FFFF0000FFFF;
+    nibbles = (nibbles | (nibbles << 8)) & 0x00FF00FF00FF00FF;
+    nibbles = (nibbles | (nibbles << 4)) & 0x0F0F0F0F0F0F0F0F;
+
+    // Bytes holding a value above 9 need to be moved from ':' onwards to 'A'
+    // onwards.
+    const uint64_t alpha =
+        ((nibbles + 0x0606060606060606) >> 4) & 0x0101010101010101;
+
+    storeBigEndian(nibbles + 0x3030303030303030 + alpha * 7, dest);
+}
+
+ProgressCode decodeProgressCode(uint64_t primaryCode,
+                                const types::Binary& secondaryCode)
+{
+    ProgressCode progressCode;
+    char* dest = progressCode.buffer.data();
+
+    // First character of reference code is in the least significant byte.
+    storeBigEndian(__builtin_bswap64(primaryCode), dest);
+    dest += ProgressCode::wordLength;
+
+    if (secondaryCode.size() > hexWordOffset)
+    {
+        const auto hexWordCount =
+            std::min((secondaryCode.size() - hexWordOffset) / hexWordSize,
+                     ProgressCode::maxHexWords);
+
+        const types::Byte* src = secondaryCode.data() + hexWordOffset;
+        for (size_t i = 0; i < hexWordCount; ++i)
+        {
+            *dest++ = ' ';
+            hexWordToAscii(src, dest);
+            src += hexWordSize;
+            dest += ProgressCode::wordLength;
+        }
+    }
+
+    progressCode.length =
+        static_cast<uint8_t>(dest - progressCode.buffer.data());
+    return progressCode;
+}
+
+} // namespace decoder
+} // namespace panel
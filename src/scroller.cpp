@@ -0,0 +1,132 @@
+#include "scroller.hpp"
+
+#include "i2c_message_encoder.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+
+namespace panel
+{
+Scroller::Scroller(std::shared_ptr<boost::asio::io_context>& io,
+                   std::shared_ptr<Transport> transport) :
+    timer(*io, "scrollStep"),
+    transport(transport)
+{
+}
+
+void Scroller::setSettings(size_t line, const Settings& settings)
+{
+    lines.at(line).settings = settings;
+}
+
+void Scroller::start(const std::string& line1, const std::string& line2)
+{
+    const auto now = Clock::now();
+    lines[0].text = line1;
+    lines[1].text = line2;
+    for (auto& line : lines)
+    {
+        // pause at the start, before the first move.
+        line.offset = 0;
+        line.nextStep = now + line.settings.endPause;
+    }
+
+    log::debug(log::Category::TRANSPORT, "Scrolling lines of length ",
+               line1.length(), " and ", line2.length());
+
+    scrolling = true;
+    lastFrame.clear();
+    render();
+    schedule();
+}
+
+void Scroller::stop()
+{
+    scrolling = false;
+    timer.cancel();
+}
+
+std::string Scroller::getView(size_t line) const
+{
+    const auto& text = lines.at(line).text;
+    if (lines[line].offset >= text.length())
+    {
+        return {};
+    }
+    return text.substr(lines[line].offset, displayWidth);
+}
+
+void Scroller::step(Line& line, Clock::time_point now)
+{
+    if (!line.isScrolled() || line.nextStep > now)
+    {
+        return;
+    }
+
+    const auto lastOffset = line.text.length() - displayWidth;
+    if (line.offset == lastOffset)
+    {
+        // back to the start, after the pause at the end.
+        line.offset = 0;
+        line.nextStep = now + line.settings.endPause;
+    }
+    else if (++line.offset == lastOffset)
+    {
+        line.nextStep = now + line.settings.endPause;
+    }
+    else
+    {
+        line.nextStep = now + line.settings.stepInterval;
+    }
+}
+
+void Scroller::render()
+{
+    // nothing is written to a detached panel, the view keeps moving.
+    if (!transport->isTransportKeyEnabled())
+    {
+        return;
+    }
+
+    auto frame = encoder::MessageEncoder().rawDisplay(getView(0), getView(1));
+    if (frame == lastFrame)
+    {
+        return;
+    }
+
+    transport->panelI2CWrite(frame);
+    lastFrame = std::move(frame);
+}
+
+void Scroller::schedule()
+{
+    const auto next = std::min_element(
+        lines.begin(), lines.end(), [](const Line& a, const Line& b) {
+            // lines that fit are never stepped.
+            if (a.isScrolled() != b.isScrolled())
+            {
+                return a.isScrolled();
+            }
+            return a.nextStep < b.nextStep;
+        });
+    if (!next->isScrolled())
+    {
+        return;
+    }
+
+    timer.expiresAt(next->nextStep, [this]() {
+        if (!scrolling)
+        {
+            return;
+        }
+
+        const auto now = Clock::now();
+        for (auto& line : lines)
+        {
+            step(line, now);
+        }
+        render();
+        schedule();
+    });
+}
+} // namespace panel
@@ -0,0 +1,310 @@
+#include "timer_wheel.hpp"
+
+#include "logger.hpp"
+#include "loop_monitor.hpp"
+
+#include <algorithm>
+
+namespace panel
+{
+TimerWheel::Timer::Timer(boost::asio::io_context& io, std::string_view name) :
+    wheel(&boost::asio::use_service<TimerWheel>(io)), name(name)
+{
+}
+
+TimerWheel::Timer::~Timer()
+{
+    cancel();
+}
+
+void TimerWheel::Timer::expiresAfter(Clock::duration duration,
+                                     Callback callback)
+{
+    expiresAt(Clock::now() + duration, std::move(callback));
+}
+
+void TimerWheel::Timer::expiresAt(Clock::time_point expiry, Callback callback)
+{
+    cancel();
+    if (wheel == nullptr)
+    {
+        return;
+    }
+
+    // an idle wheel is moved to now, so that timers are kept low.
+    if (std::all_of(wheel->levelSizes.begin(), wheel->levelSizes.end(),
+                    [](size_t size) { return size == 0; }))
+    {
+        wheel->currentTick =
+            std::max(wheel->currentTick, wheel->getElapsedTicks());
+    }
+
+    this->callback = std::move(callback);
+    expiryTick = std::max(wheel->toTick(expiry), wheel->currentTick + 1);
+    wheel->insert(*this);
+    wheel->arm();
+}
+
+void TimerWheel::Timer::cancel()
+{
+    if (isPending())
+    {
+        wheel->remove(*this);
+    }
+    callback = nullptr;
+}
+
+TimerWheel::Clock::time_point TimerWheel::Timer::getExpiry() const
+{
+    if (wheel == nullptr)
+    {
+        return Clock::time_point{};
+    }
+    return wheel->epoch + expiryTick * tickDuration;
+}
+
+TimerWheel::TimerWheel(boost::asio::execution_context& context) :
+    boost::asio::execution_context::service(context),
+    kernelTimer(std::make_unique<boost::asio::steady_timer>(
+        static_cast<boost::asio::io_context&>(context))),
+    epoch(Clock::now())
+{
+}
+
+void TimerWheel::shutdown()
+{
+    for (size_t level = 0; level < levelCount; ++level)
+    {
+        for (auto& slot : slots[level])
+        {
+            while (slot.next != &slot)
+            {
+                auto& timer = *static_cast<Timer*>(slot.next);
+                remove(timer);
+                timer.callback = nullptr;
+                timer.wheel = nullptr;
+            }
+        }
+    }
+    kernelTimer.reset();
+}
+
+uint64_t TimerWheel::toTick(Clock::time_point time) const
+{
+    if (time <= epoch)
+    {
+        return 0;
+    }
+    // rounded up, timers never expire early.
+    const auto elapsed = time - epoch + tickDuration - Clock::duration(1);
+    return static_cast<uint64_t>(elapsed / tickDuration);
+}
+
+uint64_t TimerWheel::getElapsedTicks() const
+{
+    return static_cast<uint64_t>((Clock::now() - epoch) / tickDuration);
+}
+
+void TimerWheel::insert(Timer& timer)
+{
+    const auto delta =
+        timer.expiryTick > currentTick ? timer.expiryTick - currentTick : 0;
+
+    size_t level = 0;
+    while (level + 1 < levelCount &&
+           delta >= (uint64_t(1) << (slotBits * (level + 1))))
+    {
+        ++level;
+    }
+
+    // beyond the top level, kept in its last slot and moved again later.
+    auto tick = timer.expiryTick;
+    const auto span = uint64_t(1) << (slotBits * levelCount);
+    if (delta >= span)
+    {
+        tick = currentTick + span - 1;
+    }
+
+    auto& slot = slots[level][(tick >> (slotBits * level)) & (slotCount - 1)];
+    timer.level = level;
+    timer.prev = slot.prev;
+    timer.next = &slot;
+    slot.prev->next = &timer;
+    slot.prev = &timer;
+    ++levelSizes[level];
+}
+
+void TimerWheel::remove(Timer& timer)
+{
+    timer.prev->next = timer.next;
+    timer.next->prev = timer.prev;
+    timer.prev = &timer;
+    timer.next = &timer;
+    --levelSizes[timer.level];
+}
+
+std::optional<uint64_t> TimerWheel::getNextEventTick() const
+{
+    std::optional<uint64_t> nextTick;
+    for (size_t level = 0; level < levelCount; ++level)
+    {
+        if (levelSizes[level] == 0)
+        {
+            continue;
+        }
+
+        // the slot of a level comes round at the start of its ticks.
+        const auto shift = slotBits * level;
+        const auto base = currentTick >> shift;
+        for (uint64_t step = 1; step <= slotCount; ++step)
+        {
+            const auto& slot = slots[level][(base + step) & (slotCount - 1)];
+            if (slot.next != &slot)
+            {
+                const auto tick = (base + step) << shift;
+                nextTick = std::min(nextTick.value_or(tick), tick);
+                break;
+            }
+        }
+    }
+    return nextTick;
+}
+
+void TimerWheel::advance(uint64_t targetTick)
+{
+    while (currentTick < targetTick)
+    {
+        // ticks with no slot coming round are skipped.
+        const auto nextTick = getNextEventTick();
+        if (!nextTick || *nextTick > targetTick)
+        {
+            currentTick = targetTick;
+            return;
+        }
+        currentTick = *nextTick;
+
+        // timers of a level above are moved down as their slot comes round.
+        for (size_t level = levelCount - 1; level > 0; --level)
+        {
+            const auto shift = slotBits * level;
+            if ((currentTick & ((uint64_t(1) << shift) - 1)) != 0)
+            {
+                continue;
+            }
+
+            auto& slot = slots[level][(currentTick >> shift) & (slotCount - 1)];
+            while (slot.next != &slot)
+            {
+                auto& timer = *static_cast<Timer*>(slot.next);
+                remove(timer);
+                insert(timer);
+            }
+        }
+
+        // expire the timers of the tick. Timers are taken off the slot one
+        // at a time, as a callback may cancel or schedule other timers.
+        auto& slot = slots[0][currentTick & (slotCount - 1)];
+        while (slot.next != &slot)
+        {
+            auto& timer = *static_cast<Timer*>(slot.next);
+            remove(timer);
+
+            // the timer may be scheduled again, or destroyed, by its callback.
+            auto callback = std::move(timer.callback);
+            timer.callback = nullptr;
+
+            LoopMonitor::HandlerScope scope(timer.name);
+            if (callback)
+            {
+                callback();
+            }
+        }
+    }
+}
+
+void TimerWheel::arm()
+{
+    if (!kernelTimer)
+    {
+        return;
+    }
+
+    const auto nextTick = getNextEventTick();
+    if (!nextTick)
+    {
+        armedTick.reset();
+        kernelTimer->cancel();
+        return;
+    }
+
+    if (armedTick == nextTick)
+    {
+        return;
+    }
+
+    armedTick = nextTick;
+    kernelTimer->expires_at(epoch + *nextTick * tickDuration);
+    kernelTimer->async_wait([this](const boost::system::error_code& ec) {
+        if (ec)
+        {
+            return;
+        }
+
+        armedTick.reset();
+        advance(getElapsedTicks());
+        arm();
+    });
+}
+
+TimerWheel::PendingTimers TimerWheel::getPendingTimers() const
+{
+    std::vector<std::tuple<Clock::duration, std::string>> timers;
+    for (const auto& level : slots)
+    {
+        for (const auto& slot : level)
+        {
+            for (auto link = slot.next; link != &slot; link = link->next)
+            {
+                const auto& timer = *static_cast<const Timer*>(link);
+                timers.emplace_back(
+                    epoch + timer.expiryTick * tickDuration - Clock::now(),
+                    std::string(timer.name));
+            }
+        }
+    }
+    std::sort(timers.begin(), timers.end());
+
+    PendingTimers pendingTimers;
+    for (const auto& [remaining, name] : timers)
+    {
+        pendingTimers.emplace_back(
+            name, static_cast<uint64_t>(std::max<int64_t>(
+                      std::chrono::duration_cast<std::chrono::milliseconds>(
+                          remaining)
+                          .count(),
+                      0)));
+    }
+    return pendingTimers;
+}
+
+void TimerWheel::dump() const
+{
+    const auto pendingTimers = getPendingTimers();
+    log::debug(log::Category::APP, pendingTimers.size(),
+               " timers pending at tick ", currentTick);
+    for (const auto& [name, remaining] : pendingTimers)
+    {
+        log::debug(log::Category::APP, "Timer ", name, " expires in ",
+                   remaining, " ms.");
+    }
+}
+
+void TimerWheel::registerMethods(
+    std::shared_ptr<sdbusplus::asio::dbus_interface>& iface)
+{
+    iface->register_method("GetPendingTimers", [this]() {
+        dump();
+        return getPendingTimers();
+    });
+}
+} // namespace panel
@@ -1,17 +1,136 @@
 #include "transport.hpp"
 
 #include "i2c_message_encoder.hpp"
+#include "logger.hpp"
+#include "metrics.hpp"
 
 #include <fcntl.h>
 #include <linux/i2c-dev.h>
 #include <sys/ioctl.h>
 
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
 #include <cstring>
-#include <thread>
 
 namespace panel
 {
+/* Display command of the panel. */
+static constexpr types::Byte displayCommand = 0x80;
+
+/* Scroll command of the panel. */
+static constexpr types::Byte scrollCommand = 0x88;
+
+/**
+ * @brief Check if a write failed as the device is gone.
+ * @param[in] err - errno of the write.
+ * @return true if the device has to be reopened.
+ */
+static bool isDeviceGone(int err)
+{
+    return err == EIO || err == ENXIO || err == ENODEV || err == EREMOTEIO ||
+           err == EBADF;
+}
+
+Transport::Transport(std::shared_ptr<boost::asio::io_context>& io,
+                     const std::string& devPath, const uint8_t& devAddr,
+                     const types::PanelType& type) :
+    devPath(devPath),
+    devAddress(devAddr), panelType(type),
+    recoveryTimer(
+        std::make_unique<TimerWheel::Timer>(*io, "transportRecovery")),
+    initTimer(std::make_unique<TimerWheel::Timer>(*io, "panelInit"))
+{
+    try
+    {
+        panelI2CSetup();
+    }
+    catch (const std::runtime_error& e)
+    {
+        log::error(log::Category::TRANSPORT, e.what());
+        markFailed();
+    }
+}
+
+Transport::~Transport()
+{
+    if (panelFileDescriptor != -1)
+    {
+        close(panelFileDescriptor);
+    }
+    if (recoveryPending)
+    {
+        metrics::get().transportsDown.sub();
+    }
+}
+
+void Transport::markFailed()
+{
+    if (panelFileDescriptor != -1)
+    {
+        close(panelFileDescriptor);
+        panelFileDescriptor = -1;
+    }
+
+    if (!recoveryPending)
+    {
+        recoveryPending = true;
+        metrics::get().transportsDown.add();
+        recoveryDelay = minRecoveryDelay;
+        scheduleRecovery();
+    }
+}
+
+void Transport::scheduleRecovery()
+{
+    // default constructed for testing, nothing to recover.
+    if (!recoveryTimer)
+    {
+        return;
+    }
+
+    log::info(log::Category::TRANSPORT, "Reopening ", devPath, " in ",
+              recoveryDelay.count(), " ms.");
+
+    recoveryTimer->expiresAfter(recoveryDelay, [this]() { recover(); });
+}
+
+std::chrono::milliseconds
+    Transport::nextRecoveryDelay(std::chrono::milliseconds delay)
+{
+    return std::min<std::chrono::milliseconds>(2 * delay, maxRecoveryDelay);
+}
+
+void Transport::recover()
+{
+    metrics::get().transportRecoveryAttempts.increment();
+    try
+    {
+        panelI2CSetup();
+    }
+    catch (const std::runtime_error& e)
+    {
+        log::error(log::Category::TRANSPORT, e.what());
+        recoveryDelay = nextRecoveryDelay(recoveryDelay);
+        scheduleRecovery();
+        return;
+    }
+
+    recoveryPending = false;
+    metrics::get().transportsDown.sub();
+    metrics::get().transportRecoveries.increment();
+    log::info(log::Category::TRANSPORT, "Recovered device ", devPath);
+
+    if (transportKey && panelType == types::PanelType::LCD)
+    {
+        // display is written once the panel is initialised.
+        initPanel();
+        return;
+    }
+
+    replayDisplay();
+}
+
 void Transport::panelI2CSetup()
 {
     if ((panelFileDescriptor = open(devPath.data(), O_WRONLY | O_NONBLOCK)) ==
@@ -28,6 +147,9 @@ void Transport::panelI2CSetup()
         -1) // access failure
     {
         auto err = errno;
+        close(panelFileDescriptor);
+        panelFileDescriptor = -1;
+
         std::string error = "Failed to access device path. <";
         error += devPath;
         error += "> at device address <0x";
@@ -38,32 +160,140 @@ void Transport::panelI2CSetup()
         error += strerror(err);
         throw std::runtime_error(error);
     }
-    std::cout << "\nSuccess opening and accessing the device path: " << devPath
-              << std::endl;
+    log::info(log::Category::TRANSPORT,
+              "Success opening and accessing the device path: ", devPath);
 }
 
-void Transport::panelI2CWrite(const types::Binary& buffer) const
+void Transport::panelI2CWrite(const types::Binary& buffer)
 {
-    if (transportKey)
+    // record the display, to write it again if the device is reopened.
+    if (buffer.size() > 1 && buffer[1] == displayCommand)
+    {
+        lastDisplay = buffer;
+        lastScroll.clear();
+    }
+    else if (buffer.size() > 1 && buffer[1] == scrollCommand)
     {
-        if (buffer.size()) // check if the given buffer has data in it.
+        lastScroll = buffer;
+    }
+
+    if (transportKey && !attaching)
+    {
+        if (!isHealthy())
         {
-            auto returnedSize =
-                write(panelFileDescriptor, buffer.data(), buffer.size());
-            if (returnedSize !=
-                static_cast<int>(buffer.size())) // write failure
+            // written once the device is reopened.
+            metrics::get().framesSuppressed.increment();
+        }
+        else if (buffer.size()) // check if the given buffer has data in it.
+        {
+            if (writeToDevice(buffer) && attachedAt && buffer.size() > 1 &&
+                buffer[1] == displayCommand)
             {
-                std::cerr << "\n I2C Write failure. Errno : " << errno
-                          << ". Errno description : " << strerror(errno)
-                          << ". Bytes written = " << returnedSize
-                          << ". Actual Bytes = " << buffer.size() << std::endl;
+                metrics::get().panelAttach.observe(
+                    static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - *attachedAt)
+                            .count()));
+                attachedAt.reset();
             }
         }
         else
         {
-            std::cerr << "\n Buffer empty. Skipping I2C Write." << std::endl;
+            log::error(log::Category::TRANSPORT,
+                       "Buffer empty. Skipping I2C Write.");
         }
     }
+    else
+    {
+        // written once the panel is attached.
+        metrics::get().framesSuppressed.increment();
+    }
+}
+
+bool Transport::writeToDevice(const types::Binary& buffer)
+{
+    auto returnedSize =
+        write(panelFileDescriptor, buffer.data(), buffer.size());
+    if (returnedSize != static_cast<int>(buffer.size())) // write failure
+    {
+        const auto err = errno;
+        log::error(log::Category::TRANSPORT, "I2C Write failure. Errno : ",
+                   err, ". Errno description : ", strerror(err),
+                   ". Bytes written = ", returnedSize,
+                   ". Actual Bytes = ", buffer.size());
+        metrics::get().i2cErrors.increment();
+
+        if (returnedSize == -1 && isDeviceGone(err))
+        {
+            markFailed();
+        }
+        return false;
+    }
+
+    metrics::get().framesWritten.increment();
+    return true;
+}
+
+void Transport::replayDisplay()
+{
+    // copies, as the writes record them again.
+    const auto display = lastDisplay;
+    const auto scroll = lastScroll;
+    if (!display.empty())
+    {
+        panelI2CWrite(display);
+    }
+    if (!scroll.empty())
+    {
+        panelI2CWrite(scroll);
+    }
+}
+
+void Transport::initPanel()
+{
+    attaching = true;
+    if (isHealthy())
+    {
+        writeToDevice(encoder::MessageEncoder().softReset());
+    }
+
+    // the panel is not written till the soft reset is done.
+    initTimer->expiresAfter(softResetDelay, [this]() {
+        attaching = false;
+        log::info(log::Category::TRANSPORT, "Panel:Soft reset done.");
+        doButtonConfig();
+        replayDisplay();
+    });
+}
+
+void Transport::attach(std::chrono::steady_clock::time_point presentAt)
+{
+    if (transportKey)
+    {
+        return;
+    }
+
+    log::info(log::Category::TRANSPORT, "Panel attached, initialising.");
+    attachedAt = presentAt;
+    setTransportKey(true);
+
+    // default constructed for testing, or a panel that needs no init.
+    if (!initTimer || panelType != types::PanelType::LCD)
+    {
+        replayDisplay();
+    }
+}
+
+void Transport::detach()
+{
+    if (initTimer)
+    {
+        initTimer->cancel();
+    }
+    attaching = false;
+    attachedAt.reset();
+    setTransportKey(false);
+    log::info(log::Category::TRANSPORT, "Panel detached, display suspended.");
 }
 
 void Transport::doButtonConfig()
@@ -72,15 +302,7 @@ void Transport::doButtonConfig()
     panelI2CWrite(encode.buttonControl(0x00, 0x01));
     panelI2CWrite(encode.buttonControl(0x01, 0x01));
     panelI2CWrite(encode.buttonControl(0x02, 0x01));
-    std::cout << "\n Button configuration done." << std::endl;
-}
-
-void Transport::doSoftReset()
-{
-    using namespace std::chrono_literals;
-    panelI2CWrite(encoder::MessageEncoder().softReset());
-    std::this_thread::sleep_for(100ms);
-    std::cout << "\n Panel:Soft reset done." << std::endl;
+    log::info(log::Category::TRANSPORT, "Button configuration done.");
 }
 
 void Transport::setTransportKey(bool keyValue)
@@ -88,14 +310,19 @@ void Transport::setTransportKey(bool keyValue)
     if (!transportKey && keyValue && panelType == types::PanelType::LCD)
     {
         transportKey = keyValue;
-        doSoftReset();
-        doButtonConfig();
+
+        // default constructed for testing, there is no panel to initialise.
+        if (initTimer)
+        {
+            initPanel();
+        }
     }
     else
     {
         transportKey = keyValue;
     }
-    std::cout << "\nTransport key is set to " << transportKey << std::endl;
+    log::debug(log::Category::TRANSPORT, "Transport key is set to ",
+               transportKey);
 }
 
 } // namespace panel
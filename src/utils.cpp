@@ -1,6 +1,9 @@
 #include "utils.hpp"
 
 #include "i2c_message_encoder.hpp"
+#include "logger.hpp"
+
+#include <optional>
 
 namespace panel
 {
@@ -9,6 +12,22 @@ namespace utils
 // Global variables to restore state of display lines.
 std::string restoreLine1, restoreLine2;
 
+// If the panel is scrolling the display.
+static bool panelScrolling = false;
+
+// Scroller of the lines too long for the panel to scroll.
+static std::shared_ptr<Scroller> scroller;
+
+// Timer of the end of the lamp test, to restore the display.
+static std::unique_ptr<TimerWheel::Timer> lampTestTimer;
+
+void initDisplay(boost::asio::io_context& io,
+                 std::shared_ptr<Scroller> lineScroller)
+{
+    scroller = lineScroller;
+    lampTestTimer = std::make_unique<TimerWheel::Timer>(io, "lampTest");
+}
+
 std::string binaryToHexString(const types::Binary& val)
 {
     std::ostringstream oss;
@@ -20,43 +39,101 @@ std::string binaryToHexString(const types::Binary& val)
     return oss.str();
 }
 
+/**
+ * @brief Stop the scroll of the panel, if scrolling.
+ * @param[in] transport - Transport class object to access panelI2CWrite
+ * method.
+ */
+static void stopPanelScroll(std::shared_ptr<Transport>& transport)
+{
+    if (panelScrolling)
+    {
+        transport->panelI2CWrite(encoder::MessageEncoder().stopScroll());
+        panelScrolling = false;
+    }
+}
+
 void sendCurrDisplayToPanel(const std::string& line1, const std::string& line2,
-                            std::shared_ptr<Transport> transport)
+                            std::shared_ptr<Transport> transport,
+                            types::Byte scrollRate)
 {
-    // TODO: via https://github.com/ibm-openbmc/ibm-panel/issues/37
-    // Make these couts and other traces in the code configurable. Keeping
-    // these commented until then as they flood the systemd journal.
-    // couts are for debugging purpose. can be removed once the testing is done.
-    // std::cout << "L1 : " << line1 << std::endl;
-    // std::cout << "L2 : " << line2 << std::endl;
+    log::debug(log::Category::TRANSPORT, "L1 : ", line1);
+    log::debug(log::Category::TRANSPORT, "L2 : ", line2);
 
     // Restore the values of display lines
     restoreLine1 = line1;
     restoreLine2 = line2;
 
+    if (scroller)
+    {
+        if (Scroller::isNeeded(line1, line2))
+        {
+            stopPanelScroll(transport);
+            scroller->start(line1, line2);
+            return;
+        }
+        scroller->stop();
+    }
+
     encoder::MessageEncoder encode;
 
     auto displayPacket = encode.rawDisplay(line1, line2);
 
-    transport->panelI2CWrite(displayPacket);
-
+    std::optional<types::ScrollType> scrollType;
     if ((line1.length() > 16) && (line2.length() > 16))
     {
-        transport->panelI2CWrite(encode.scroll(
-            static_cast<types::Byte>(types::ScrollType::BOTH_LEFT)));
+        scrollType = types::ScrollType::BOTH_LEFT;
     }
     else if (line1.length() > 16)
     {
-        transport->panelI2CWrite(encode.scroll(
-            static_cast<types::Byte>(types::ScrollType::LINE1_LEFT)));
+        scrollType = types::ScrollType::LINE1_LEFT;
     }
     else if (line2.length() > 16)
     {
-        transport->panelI2CWrite(encode.scroll(
-            static_cast<types::Byte>(types::ScrollType::LINE2_LEFT)));
+        scrollType = types::ScrollType::LINE2_LEFT;
+    }
+
+    // the lines fit, stop the scroll of the last display.
+    if (!scrollType)
+    {
+        stopPanelScroll(transport);
+    }
+
+    transport->panelI2CWrite(displayPacket);
+
+    if (scrollType)
+    {
+        transport->panelI2CWrite(encode.scroll(*scrollType, scrollRate));
+        panelScrolling = true;
     }
 }
 
+DisplayFrame makeDisplayFrame(const std::string& line1,
+                              const std::string& line2)
+{
+    encoder::MessageEncoder encode;
+    return {line1, line2, encode.rawDisplay(line1, line2)};
+}
+
+void sendDisplayFrameToPanel(const DisplayFrame& displayFrame,
+                             std::shared_ptr<Transport> transport)
+{
+    log::debug(log::Category::TRANSPORT, "L1 : ", displayFrame.line1);
+    log::debug(log::Category::TRANSPORT, "L2 : ", displayFrame.line2);
+
+    // Restore the values of display lines
+    restoreLine1 = displayFrame.line1;
+    restoreLine2 = displayFrame.line2;
+
+    if (scroller)
+    {
+        scroller->stop();
+    }
+    stopPanelScroll(transport);
+
+    transport->panelI2CWrite(displayFrame.frame);
+}
+
 void readSystemOperatingMode(std::string& sysOperatingMode)
 {
     auto readLogSettings = readBusProperty<std::variant<bool>>(
@@ -74,9 +151,22 @@ void readSystemOperatingMode(std::string& sysOperatingMode)
         "/xyz/openbmc_project/control/host0/auto_reboot",
         "xyz.openbmc_project.Control.Boot.RebootPolicy", "AutoReboot");
 
-    const auto loggingService = std::get_if<bool>(&readLogSettings);
-    const auto restorePolicy = std::get_if<std::string>(&readRestorePolicy);
-    const auto autoRebootPolicy = std::get_if<bool>(&readRebootPolicy);
+    const auto mode = getSystemOperatingMode(readLogSettings, readRestorePolicy,
+                                             readRebootPolicy);
+    if (!mode.empty())
+    {
+        sysOperatingMode = mode;
+    }
+}
+
+std::string
+    getSystemOperatingMode(const std::variant<bool>& quiesceOnHwError,
+                           const std::variant<std::string>& powerRestorePolicy,
+                           const std::variant<bool>& autoReboot)
+{
+    const auto loggingService = std::get_if<bool>(&quiesceOnHwError);
+    const auto restorePolicy = std::get_if<std::string>(&powerRestorePolicy);
+    const auto autoRebootPolicy = std::get_if<bool>(&autoReboot);
 
     if (loggingService != nullptr && restorePolicy != nullptr &&
         autoRebootPolicy != nullptr)
@@ -86,17 +176,13 @@ void readSystemOperatingMode(std::string& sysOperatingMode)
                               "RestorePolicy.Policy.AlwaysOff" &&
             *autoRebootPolicy == false)
         {
-            sysOperatingMode = "Manual";
-        }
-        else
-        {
-            sysOperatingMode = "Normal";
+            return "Manual";
         }
+        return "Normal";
     }
-    else
-    {
-        std::cerr << "Failed to read Bus property" << std::endl;
-    }
+
+    log::error(log::Category::BUS, "Failed to read Bus property");
+    return {};
 }
 
 types::SystemParameterValues readSystemParameters()
@@ -106,14 +192,23 @@ types::SystemParameterValues readSystemParameters()
         "/xyz/openbmc_project/bios_config/manager",
         "xyz.openbmc_project.BIOSConfig.Manager", "BaseBIOSTable");
 
-    const auto baseBiosTable = std::get_if<types::BiosBaseTable>(&retVal);
+    std::string systemOperatingMode{};
+    readSystemOperatingMode(systemOperatingMode);
+
+    return getSystemParameters(retVal, systemOperatingMode);
+}
+
+types::SystemParameterValues getSystemParameters(
+    const std::variant<types::BiosBaseTable>& biosTable,
+    const std::string& systemOperatingMode)
+{
+    const auto baseBiosTable = std::get_if<types::BiosBaseTable>(&biosTable);
 
     // system parameters to be read from BIOS table
     std::string OSBootType{};
     std::string HMCManaged{};
     std::string FWIPLType{};
     std::string hypType{};
-    std::string systemOperatingMode{};
 
     if (baseBiosTable != nullptr)
     {
@@ -146,11 +241,9 @@ types::SystemParameterValues readSystemParameters()
     }
     else
     {
-        std::cerr << "Failed to read BIOS base table" << std::endl;
+        log::error(log::Category::BUS, "Failed to read BIOS base table");
     }
 
-    readSystemOperatingMode(systemOperatingMode);
-
     return std::make_tuple(OSBootType, systemOperatingMode, HMCManaged,
                            FWIPLType, hypType);
 }
@@ -165,12 +258,13 @@ types::GetManagedObjects getManagedObjects(const std::string& service,
         auto properties = bus.new_method_call(
             service.c_str(), object.c_str(),
             "org.freedesktop.DBus.ObjectManager", "GetManagedObjects");
+        metrics::CallTimer timer(metrics::get().getDbusCallLatency(service));
         auto result = bus.call(properties);
         result.read(retVal);
     }
     catch (const sdbusplus::exception::SdBusError& e)
     {
-        std::cerr << e.what();
+        log::error(log::Category::BUS, e.what());
     }
     return retVal;
 }
@@ -194,6 +288,8 @@ std::vector<std::string> getBootSidePaths()
     mapperCall.append(depth);
     mapperCall.append(intf);
 
+    metrics::CallTimer timer(
+        metrics::get().getDbusCallLatency("xyz.openbmc_project.ObjectMapper"));
     auto response = bus.call(mapperCall);
     response.read(result);
 
@@ -216,80 +312,104 @@ void getNextBootSide(std::string& nextBootSide)
                 "/xyz/openbmc_project/software/functional",
                 "xyz.openbmc_project.Association", "endpoints");
 
-        const auto functionalFw = std::get_if<std::vector<std::string>>(&res);
-        if ((functionalFw == nullptr) || (functionalFw->size() == 0))
+        const auto runningImagePath = findRunningImage(bootSidePaths, res);
+
+        auto resp = utils::readBusProperty<std::variant<uint8_t>>(
+            "xyz.openbmc_project.Software.BMC.Updater", runningImagePath,
+            "xyz.openbmc_project.Software.RedundancyPriority", "Priority");
+
+        if (const auto bootSide = getBootSide(resp); !bootSide.empty())
         {
-            // We could not get any functional FW. This should not be a
-            // situation. log error.
-            throw std::runtime_error("Error fetching functionalFw");
+            nextBootSide = bootSide;
         }
+    }
+    else
+    {
+        log::warning(log::Category::BUS,
+                     "Boot side path not equal to 2. Always mark selected side "
+                     "as P");
+    }
+}
 
-        std::cout << "Functional Image size = " << functionalFw->size()
-                  << std::endl;
-
-        bool runningImageFound = false;
-        std::string runningImagePath{};
+std::string
+    findRunningImage(const std::vector<std::string>& bootSidePaths,
+                     const std::variant<std::vector<std::string>>& functional)
+{
+    const auto functionalFw =
+        std::get_if<std::vector<std::string>>(&functional);
+    if ((functionalFw == nullptr) || (functionalFw->size() == 0))
+    {
+        // We could not get any functional FW. This should not be a
+        // situation. log error.
+        throw std::runtime_error("Error fetching functionalFw");
+    }
 
-        for (const auto& item : *functionalFw)
-        {
-            auto pos =
-                std::find(bootSidePaths.begin(), bootSidePaths.end(), item);
+    log::debug(log::Category::BUS, "Functional Image size = ",
+               functionalFw->size());
 
-            if (pos != bootSidePaths.end())
-            {
-                runningImagePath = *pos;
-                runningImageFound = true;
-                std::cout << "Running image found" << runningImagePath
-                          << std::endl;
-                break;
-            }
-        }
+    for (const auto& item : *functionalFw)
+    {
+        auto pos = std::find(bootSidePaths.begin(), bootSidePaths.end(), item);
 
-        if (!runningImageFound)
+        if (pos != bootSidePaths.end())
         {
-            throw std::runtime_error("Functional fw not found in boot paths");
+            log::debug(log::Category::BUS, "Running image found", *pos);
+            return *pos;
         }
+    }
 
-        auto resp = utils::readBusProperty<std::variant<uint8_t>>(
-            "xyz.openbmc_project.Software.BMC.Updater", runningImagePath,
-            "xyz.openbmc_project.Software.RedundancyPriority", "Priority");
+    throw std::runtime_error("Functional fw not found in boot paths");
+}
 
-        if (const auto imagePriority = std::get_if<uint8_t>(&resp);
-            (imagePriority != nullptr))
-        {
-            // implies this is the running image and it is also marked for next
-            // boot.
-            if (*imagePriority == 0)
-            {
-                nextBootSide = "P";
-            }
-            // implies running image is not marked for next boot.
-            else if (*imagePriority == 1)
-            {
-                nextBootSide = "T";
-            }
-        }
-        else
-        {
-            throw std::runtime_error("Failed to read boot priority property");
-        }
+std::string getBootSide(const std::variant<uint8_t>& priority)
+{
+    const auto imagePriority = std::get_if<uint8_t>(&priority);
+    if (imagePriority == nullptr)
+    {
+        throw std::runtime_error("Failed to read boot priority property");
     }
-    else
+
+    // implies this is the running image and it is also marked for next
+    // boot.
+    if (*imagePriority == 0)
     {
-        std::cout << "Boot side path not equal to 2. Always mark "
-                     "selected side as P"
-                  << std::endl;
+        return "P";
     }
+    // implies running image is not marked for next boot.
+    if (*imagePriority == 1)
+    {
+        return "T";
+    }
+    return {};
 }
 
 void doLampTest(std::shared_ptr<Transport>& transport)
 {
+    // display is restored, and scrolled again, after the lamp test.
+    if (scroller)
+    {
+        scroller->stop();
+    }
     transport->panelI2CWrite(encoder::MessageEncoder().lampTest());
-    std::cout << "\nPanel lamp test initiated." << std::endl;
+    log::info(log::Category::BUS, "Panel lamp test initiated.");
+
+    if (lampTestTimer)
+    {
+        lampTestTimer->expiresAfter(
+            std::chrono::seconds(encoder::MessageEncoder::lampTestDuration),
+            [transport]() mutable {
+                log::info(log::Category::BUS, "Panel lamp test completed.");
+                sendCurrDisplayToPanel(restoreLine1, restoreLine2, transport);
+            });
+    }
 }
 
 void restoreDisplayOnPanel(std::shared_ptr<Transport>& transport)
 {
+    if (lampTestTimer)
+    {
+        lampTestTimer->cancel();
+    }
     sendCurrDisplayToPanel(restoreLine1, restoreLine2, transport);
 }
 
@@ -0,0 +1,116 @@
+#include "worker_pool.hpp"
+
+#include <boost/asio/post.hpp>
+
+namespace panel
+{
+#ifdef PANEL_WORKER_THREADS
+WorkerPool::WorkerPool(std::shared_ptr<boost::asio::io_context>& io,
+                       size_t threadCount) :
+    io(io)
+{
+    workers.reserve(threadCount);
+    for (size_t count = 0; count < threadCount; ++count)
+    {
+        workers.emplace_back([this]() { runWorker(); });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+    jobQueued.notify_all();
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void WorkerPool::submit(Work work, Completion completion)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.emplace_back(
+            Job{nextSequence++, std::move(work), std::move(completion)});
+    }
+    jobQueued.notify_one();
+}
+
+void WorkerPool::runWorker()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        jobQueued.wait(lock, [this]() { return stopped || !jobs.empty(); });
+        if (stopped)
+        {
+            return;
+        }
+
+        auto job = std::move(jobs.front());
+        jobs.pop_front();
+
+        lock.unlock();
+        std::exception_ptr error;
+        try
+        {
+            job.work();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        lock.lock();
+
+        finished.emplace(job.sequence,
+                         std::make_pair(std::move(job.completion), error));
+        postCompletions();
+    }
+}
+
+void WorkerPool::postCompletions()
+{
+    // posted under the lock, so the completions are queued in order.
+    for (auto it = finished.find(nextCompletion); it != finished.end();
+         it = finished.find(nextCompletion))
+    {
+        boost::asio::post(*io, [completion = std::move(it->second.first),
+                                error = it->second.second]() {
+            completion(error);
+        });
+        finished.erase(it);
+        nextCompletion++;
+    }
+}
+#else
+WorkerPool::WorkerPool(std::shared_ptr<boost::asio::io_context>& io,
+                       size_t) :
+    io(io)
+{
+}
+
+WorkerPool::~WorkerPool() = default;
+
+void WorkerPool::submit(Work work, Completion completion)
+{
+    // handlers are run in the order posted, so completions stay in order.
+    boost::asio::post(*io, [work = std::move(work),
+                            completion = std::move(completion)]() {
+        std::exception_ptr error;
+        try
+        {
+            work();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        completion(error);
+    });
+}
+#endif
+} // namespace panel
@@ -0,0 +1,192 @@
+#include "async_utils.hpp"
+#include "pldm_responder.hpp"
+
+#include <boost/asio/co_spawn.hpp>
+
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+using namespace panel;
+using namespace std::chrono_literals;
+using panel::test::PldmResponder;
+
+class AsyncUtilsTest : public ::testing::Test
+{
+  protected:
+    // Start the responder, returns false if it could not be started.
+    bool start()
+    {
+        try
+        {
+            responder = std::make_unique<PldmResponder>();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            return false;
+        }
+
+        io = std::make_shared<boost::asio::io_context>();
+        conn = responder->connect(*io);
+        return true;
+    }
+
+    // Run the coroutine on the event loop till it completes.
+    bool run(boost::asio::awaitable<void> coroutine)
+    {
+        bool done = false;
+        boost::asio::co_spawn(*io, std::move(coroutine),
+                              [&done](std::exception_ptr error) {
+                                  EXPECT_FALSE(error);
+                                  done = true;
+                              });
+
+        const auto deadline = std::chrono::steady_clock::now() + 10s;
+        while (!done && std::chrono::steady_clock::now() < deadline)
+        {
+            io->restart();
+            io->run_for(10ms);
+        }
+        return done;
+    }
+
+    std::unique_ptr<PldmResponder> responder;
+    std::shared_ptr<boost::asio::io_context> io;
+    std::shared_ptr<sdbusplus::asio::connection> conn;
+};
+
+TEST_F(AsyncUtilsTest, methodCall)
+{
+    if (!start())
+    {
+        GTEST_SKIP() << "PLDM responder could not be started.";
+    }
+
+    std::vector<uint8_t> instanceIds;
+    ASSERT_TRUE(run([&]() -> boost::asio::awaitable<void> {
+        for (size_t count = 0; count < 2; ++count)
+        {
+            instanceIds.push_back(co_await utils::asyncMethodCall<uint8_t>(
+                *conn, "xyz.openbmc_project.PLDM", "/xyz/openbmc_project/pldm",
+                "xyz.openbmc_project.PLDM.Requester", "GetInstanceId",
+                PldmResponder::mctpEid));
+        }
+    }()));
+
+    ASSERT_EQ(2u, instanceIds.size());
+    EXPECT_NE(instanceIds[0], instanceIds[1]);
+    EXPECT_EQ(2u, responder->getInstanceIdRequestCount());
+}
+
+TEST_F(AsyncUtilsTest, readFailure)
+{
+    if (!start())
+    {
+        GTEST_SKIP() << "PLDM responder could not be started.";
+    }
+
+    // errors are logged and an empty value is returned.
+    std::variant<std::string> value{"not read"};
+    ASSERT_TRUE(run([&]() -> boost::asio::awaitable<void> {
+        value = co_await utils::asyncReadBusProperty<std::variant<std::string>>(
+            *conn, "xyz.openbmc_project.Inventory.Manager",
+            "/xyz/openbmc_project/inventory/system",
+            "xyz.openbmc_project.Inventory.Decorator.Asset", "SerialNumber");
+    }()));
+
+    EXPECT_EQ("", std::get<std::string>(value));
+}
+
+TEST_F(AsyncUtilsTest, getAllFailure)
+{
+    if (!start())
+    {
+        GTEST_SKIP() << "PLDM responder could not be started.";
+    }
+
+    // an interface that could not be read does not fail the others.
+    std::vector<types::PropertyMap> properties;
+    ASSERT_TRUE(run([&]() -> boost::asio::awaitable<void> {
+        std::vector<types::ObjectInterface> interfaces;
+        interfaces.emplace_back("/xyz/openbmc_project/pldm",
+                                "xyz.openbmc_project.PLDM.PDR");
+        interfaces.emplace_back(
+            "/xyz/openbmc_project/inventory/system",
+            "xyz.openbmc_project.Inventory.Decorator.Asset");
+        properties = co_await utils::asyncGetAllProperties(
+            *conn, "xyz.openbmc_project.PLDM", std::move(interfaces));
+    }()));
+
+    ASSERT_EQ(2u, properties.size());
+    EXPECT_TRUE(properties[0].empty());
+    EXPECT_TRUE(properties[1].empty());
+    EXPECT_EQ(nullptr,
+              utils::getProperty<std::string>(properties[1], "SerialNumber"));
+}
+
+TEST_F(AsyncUtilsTest, getAllProperties)
+{
+    if (!start())
+    {
+        GTEST_SKIP() << "PLDM responder could not be started.";
+    }
+
+    // properties are returned in the order of the interfaces, whichever
+    // reply comes first.
+    std::vector<types::PropertyMap> properties;
+    ASSERT_TRUE(run([&]() -> boost::asio::awaitable<void> {
+        std::vector<types::ObjectInterface> interfaces;
+        interfaces.emplace_back(PldmResponder::panelObject,
+                                "xyz.openbmc_project.Inventory.Item");
+        interfaces.emplace_back(
+            "/xyz/openbmc_project/inventory/system",
+            "xyz.openbmc_project.Inventory.Decorator.Asset");
+        interfaces.emplace_back(
+            PldmResponder::panelObject,
+            "xyz.openbmc_project.Inventory.Decorator.Asset");
+        properties = co_await utils::asyncGetAllProperties(
+            *conn, "xyz.openbmc_project.PLDM", std::move(interfaces));
+    }()));
+
+    ASSERT_EQ(3u, properties.size());
+
+    const auto present = utils::getProperty<bool>(properties[0], "Present");
+    ASSERT_NE(nullptr, present);
+    EXPECT_TRUE(*present);
+    const auto name =
+        utils::getProperty<std::string>(properties[0], "PrettyName");
+    ASSERT_NE(nullptr, name);
+    EXPECT_EQ(PldmResponder::panelName, *name);
+
+    EXPECT_TRUE(properties[1].empty());
+
+    const auto serialNumber =
+        utils::getProperty<std::string>(properties[2], "SerialNumber");
+    ASSERT_NE(nullptr, serialNumber);
+    EXPECT_EQ(PldmResponder::panelSerialNumber, *serialNumber);
+    const auto model = utils::getProperty<std::string>(properties[2], "Model");
+    ASSERT_NE(nullptr, model);
+    EXPECT_EQ(PldmResponder::panelModel, *model);
+
+    // a property of another type, or not read, is not returned.
+    EXPECT_EQ(nullptr, utils::getProperty<bool>(properties[2], "Model"));
+    EXPECT_EQ(nullptr, utils::getProperty<std::string>(properties[2],
+                                                       "PartNumber"));
+}
+
+TEST_F(AsyncUtilsTest, getAllNoInterfaces)
+{
+    if (!start())
+    {
+        GTEST_SKIP() << "PLDM responder could not be started.";
+    }
+
+    std::vector<types::PropertyMap> properties(1);
+    ASSERT_TRUE(run([&]() -> boost::asio::awaitable<void> {
+        properties = co_await utils::asyncGetAllProperties(
+            *conn, "xyz.openbmc_project.PLDM", {});
+    }()));
+
+    EXPECT_TRUE(properties.empty());
+}
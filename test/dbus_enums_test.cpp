@@ -0,0 +1,52 @@
+#include "dbus_enums.hpp"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace panel::types;
+
+// strings are parsed at compile time as well.
+static_assert(bmcStateParser.parse(
+                  "xyz.openbmc_project.State.BMC.BMCState.Ready") ==
+              BMCState::READY);
+
+TEST(DbusEnums, knownStrings)
+{
+    EXPECT_EQ(BMCState::NOT_READY,
+              bmcStateParser.parse(
+                  "xyz.openbmc_project.State.BMC.BMCState.NotReady"));
+    EXPECT_EQ(PowerState::ON,
+              powerStateParser.parse(
+                  "xyz.openbmc_project.State.Chassis.PowerState.On"));
+    EXPECT_EQ(PowerState::TRANSITIONING_TO_OFF,
+              powerStateParser.parse("xyz.openbmc_project.State.Chassis."
+                                     "PowerState.TransitioningToOff"));
+    EXPECT_EQ(BootProgress::OS_RUNNING,
+              bootProgressParser.parse("xyz.openbmc_project.State.Boot."
+                                       "Progress.ProgressStages.OSRunning"));
+    EXPECT_EQ(BootProgress::MOTHERBOARD_INIT,
+              bootProgressParser.parse("xyz.openbmc_project.State.Boot."
+                                       "Progress.ProgressStages."
+                                       "MotherboardInit"));
+    EXPECT_EQ(RestorePolicy::ALWAYS_OFF,
+              restorePolicyParser.parse("xyz.openbmc_project.Control.Power."
+                                        "RestorePolicy.Policy.AlwaysOff"));
+}
+
+TEST(DbusEnums, unknownStrings)
+{
+    EXPECT_EQ(BMCState::UNKNOWN, bmcStateParser.parse(""));
+    EXPECT_EQ(PowerState::UNKNOWN, powerStateParser.parse("On"));
+
+    // same suffix, different enum.
+    EXPECT_EQ(BootProgress::UNKNOWN,
+              bootProgressParser.parse("xyz.openbmc_project.State.Host."
+                                       "ProgressStages.OSRunning"));
+
+    // same length and suffix as a known string.
+    std::string policy("xyz.openbmc_project.Control.Power.RestorePolicy."
+                       "Policy.AlwaysOn");
+    policy[0] = 'a';
+    EXPECT_EQ(RestorePolicy::UNKNOWN, restorePolicyParser.parse(policy));
+}
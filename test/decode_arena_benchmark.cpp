@@ -0,0 +1,264 @@
+#include "decode_arena.hpp"
+#include "private_bus.hpp"
+#include "types.hpp"
+
+#include <systemd/sd-bus.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace panel;
+using panel::test::PrivateBus;
+using Clock = std::chrono::steady_clock;
+
+/* Heap allocations made by the benchmark. */
+static std::atomic<size_t> allocations{0};
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+/* Number of times the synthesized traffic is decoded per run. */
+static constexpr size_t replayCount = 2000;
+
+/**
+ * @brief A synthesized signal, with the callback decode of the signal.
+ */
+struct SynthesizedSignal
+{
+    sdbusplus::message::message msg;
+    std::function<void(sdbusplus::message::message&)> decodeStd;
+    std::function<void(sdbusplus::message::message&)> decodePmr;
+};
+
+/**
+ * @brief Seal a signal, so that it can be decoded as if it was received.
+ * @param[in] msg - Signal to seal.
+ */
+static void seal(sdbusplus::message::message& msg)
+{
+    static uint64_t cookie = 1;
+    if (sd_bus_message_seal(msg.get(), cookie++, 0) < 0)
+    {
+        throw std::runtime_error("Failed to seal the signal.");
+    }
+}
+
+/**
+ * @brief Synthesize a property change of a state, as decoded by SystemStatus.
+ * @param[in] conn - Bus connection to create the signal on.
+ * @param[in] object - Object path.
+ * @param[in] interface - Interface of the state.
+ * @param[in] property - State property.
+ * @param[in] value - New state.
+ * @return The synthesized signal.
+ */
+static SynthesizedSignal synthesizeStateChange(
+    sdbusplus::asio::connection& conn, const std::string& object,
+    const std::string& interface, const std::string& property,
+    const std::string& value)
+{
+    auto msg = conn.new_signal(object.c_str(),
+                               "org.freedesktop.DBus.Properties",
+                               "PropertiesChanged");
+    msg.append(interface,
+               std::map<std::string, std::variant<std::string>>{
+                   {property, value}},
+               std::vector<std::string>{});
+    seal(msg);
+
+    return {std::move(msg),
+            [](sdbusplus::message::message& msg) {
+                std::string object{};
+                types::ItemInterfaceMap invItemMap;
+                msg.read(object, invItemMap);
+            },
+            [](sdbusplus::message::message& msg) {
+                DecodeArena arena;
+                std::string object{};
+                types::pmr::ItemInterfaceMap invItemMap;
+                msg.read(object, invItemMap);
+            }};
+}
+
+/**
+ * @brief Synthesize a PEL being logged, as decoded by PELListener.
+ * @param[in] conn - Bus connection to create the signal on.
+ * @param[in] id - Id of the PEL.
+ * @return The synthesized signal.
+ */
+static SynthesizedSignal synthesizePel(sdbusplus::asio::connection& conn,
+                                       uint32_t id)
+{
+    auto msg = conn.new_signal("/xyz/openbmc_project/logging",
+                               "org.freedesktop.DBus.ObjectManager",
+                               "InterfacesAdded");
+
+    const types::DbusInterfaceMap interfaces{
+        {"xyz.openbmc_project.Logging.Entry",
+         {{"Id", id},
+          {"Severity",
+           std::string("xyz.openbmc_project.Logging.Entry.Level.Error")},
+          {"Message",
+           std::string("xyz.openbmc_project.Common.Error.InternalFailure")},
+          {"AdditionalData",
+           std::vector<std::string>{
+               "_PID=1234",
+               "CALLOUT_INVENTORY_PATH=/xyz/openbmc_project/inventory/system/"
+               "chassis/motherboard"}},
+          {"Resolution",
+           std::string("1. Location Code: U78DA.ND0.WZS0042-P0\n"
+                       "   Priority: High\n")},
+          {"Resolved", false},
+          {"Timestamp", uint64_t(1700000000000)},
+          {"EventId", std::string("BD8D1002 00000055 2E2D0010 00000000 "
+                                  "00000000 00000000 00000000 00000000 "
+                                  "00000000")}}},
+        {"xyz.openbmc_project.Association.Definitions",
+         {{"Associations",
+           std::vector<std::tuple<std::string, std::string, std::string>>{
+               {"callout", "fault",
+                "/xyz/openbmc_project/inventory/system/chassis/"
+                "motherboard"}}}}},
+        {"xyz.openbmc_project.Object.Delete", {}},
+        {"xyz.openbmc_project.Software.Version",
+         {{"Version", std::string("fw1020.00-16")}}}};
+
+    msg.append(sdbusplus::message::object_path(
+                   "/xyz/openbmc_project/logging/entry/" + std::to_string(id)),
+               interfaces);
+    seal(msg);
+
+    return {std::move(msg),
+            [](sdbusplus::message::message& msg) {
+                sdbusplus::message::object_path objPath;
+                types::DbusInterfaceMap infMap;
+                msg.read(objPath, infMap);
+            },
+            [](sdbusplus::message::message& msg) {
+                DecodeArena arena;
+                sdbusplus::message::object_path objPath;
+                types::pmr::DbusInterfaceMap infMap;
+                msg.read(objPath, infMap);
+            }};
+}
+
+/**
+ * @brief Synthesize the signals seen by the panel over an IPL.
+ * @param[in] conn - Bus connection to create the signals on.
+ * @return The synthesized signals.
+ */
+static std::vector<SynthesizedSignal>
+    synthesizeIplTraffic(sdbusplus::asio::connection& conn)
+{
+    std::vector<SynthesizedSignal> traffic;
+    traffic.push_back(synthesizeStateChange(
+        conn, "/xyz/openbmc_project/state/bmc0",
+        "xyz.openbmc_project.State.BMC", "CurrentBMCState",
+        "xyz.openbmc_project.State.BMC.BMCState.Ready"));
+    traffic.push_back(synthesizeStateChange(
+        conn, "/xyz/openbmc_project/state/chassis0",
+        "xyz.openbmc_project.State.Chassis", "CurrentPowerState",
+        "xyz.openbmc_project.State.Chassis.PowerState.On"));
+
+    for (const auto stage :
+         {"PrimaryProcInit", "MemoryInit", "SecondaryProcInit",
+          "MotherboardInit", "SystemInitComplete", "OSStart", "OSRunning"})
+    {
+        traffic.push_back(synthesizeStateChange(
+            conn, "/xyz/openbmc_project/state/host0",
+            "xyz.openbmc_project.State.Boot.Progress", "BootProgress",
+            std::string("xyz.openbmc_project.State.Boot.Progress."
+                        "ProgressStages.") +
+                stage));
+    }
+
+    for (uint32_t id = 1; id <= 3; ++id)
+    {
+        traffic.push_back(synthesizePel(conn, id));
+    }
+    return traffic;
+}
+
+/**
+ * @brief Decode the synthesized traffic and print allocations per signal.
+ * @param[in] traffic - Synthesized signals.
+ * @param[in] usePmr - If decoded into the pmr types.
+ */
+static void runDecode(std::vector<SynthesizedSignal>& traffic, bool usePmr)
+{
+    const auto allocationsBefore = allocations.load();
+    const auto start = Clock::now();
+
+    for (size_t count = 0; count < replayCount; ++count)
+    {
+        for (auto& signal : traffic)
+        {
+            sd_bus_message_rewind(signal.msg.get(), true);
+            usePmr ? signal.decodePmr(signal.msg)
+                   : signal.decodeStd(signal.msg);
+        }
+    }
+
+    const auto elapsed = Clock::now() - start;
+    const auto signals = replayCount * traffic.size();
+    const auto perSignal = static_cast<double>(allocations.load() -
+                                               allocationsBefore) /
+                           signals;
+
+    std::cout << std::left << std::setw(5) << (usePmr ? "pmr" : "std")
+              << " allocations/signal " << std::setw(8) << std::fixed
+              << std::setprecision(2) << perSignal << " ns/signal "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                         .count() /
+                     signals
+              << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        // signals are built on a connection, to a bus of the benchmark.
+        PrivateBus bus;
+        boost::asio::io_context io;
+        auto conn = bus.connect(io);
+
+        auto traffic = synthesizeIplTraffic(*conn);
+        std::cout << "Decode of " << traffic.size()
+                  << " synthesized signals, replayed " << replayCount
+                  << " times" << std::endl;
+
+        runDecode(traffic, false);
+        runDecode(traffic, true);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,47 @@
+#include "decode_arena.hpp"
+#include "types.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace panel;
+
+TEST(DecodeArena, defaultResource)
+{
+    const auto previous = std::pmr::get_default_resource();
+    {
+        DecodeArena arena;
+        EXPECT_NE(previous, std::pmr::get_default_resource());
+    }
+    EXPECT_EQ(previous, std::pmr::get_default_resource());
+}
+
+TEST(DecodeArena, nestedContainers)
+{
+    DecodeArena arena;
+    const auto resource = std::pmr::get_default_resource();
+
+    types::pmr::DbusInterfaceMap infMap;
+    auto& propMap = infMap["xyz.openbmc_project.Logging.Entry"];
+    propMap.emplace("AdditionalData", std::pmr::vector<std::string>{"_PID=1"});
+
+    EXPECT_EQ(resource, infMap.get_allocator().resource());
+    EXPECT_EQ(resource, propMap.get_allocator().resource());
+
+    const auto data = std::get_if<std::pmr::vector<std::string>>(
+        &propMap.at("AdditionalData"));
+    ASSERT_NE(nullptr, data);
+    EXPECT_EQ(resource, data->get_allocator().resource());
+    EXPECT_EQ("_PID=1", data->front());
+}
+
+TEST(DecodeArena, nestedArena)
+{
+    DecodeArena outer;
+    const auto outerResource = std::pmr::get_default_resource();
+    {
+        DecodeArena inner;
+        types::pmr::ItemInterfaceMap invItemMap{{"Present", true}};
+        EXPECT_NE(outerResource, invItemMap.get_allocator().resource());
+    }
+    EXPECT_EQ(outerResource, std::pmr::get_default_resource());
+}
@@ -0,0 +1,37 @@
+#include "executor.hpp"
+#include "metrics.hpp"
+#include "transport.hpp"
+#include "worker_pool.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace panel;
+
+TEST(Executor, destructiveFunctions)
+{
+    EXPECT_TRUE(Executor::isDestructive(3, {}));
+    EXPECT_TRUE(Executor::isDestructive(73, {}));
+    EXPECT_FALSE(Executor::isDestructive(1, {}));
+
+    // dump policy writes, but not its view.
+    EXPECT_TRUE(Executor::isDestructive(55, {0x01}));
+    EXPECT_TRUE(Executor::isDestructive(55, {0x02}));
+    EXPECT_FALSE(Executor::isDestructive(55, {0x00}));
+}
+
+TEST(Executor, dumpPolicyWriteInFlight)
+{
+    auto io = std::make_shared<boost::asio::io_context>();
+    auto workers = std::make_shared<WorkerPool>(io);
+    Executor executor(std::make_shared<Transport>(), nullptr, nullptr,
+                      workers);
+
+    auto& rejected = metrics::get().functionsRejected;
+    const auto before = rejected.get();
+
+    // the write completes on the event loop, which is not run meanwhile.
+    executor.executeFunction(55, {0x01});
+    executor.executeFunction(55, {0x02});
+    executor.executeFunction(55, {0x01});
+    EXPECT_EQ(before + 2, rejected.get());
+}
@@ -105,6 +105,20 @@ TEST(MessageEncoder, scroll)
 
     Binary validData2 = {0xFF, 0x88, 0x23, 10, 1, 74};
     EXPECT_EQ(validData2, msgEncode.scroll(0x23));
+
+    // rate and character count
+    Binary validData3 = {0xFF, 0x88, 0x03, 5, 4, 108};
+    EXPECT_EQ(validData3, msgEncode.scroll(ScrollType::BOTH_LEFT_STEP, 5, 4));
+
+    Binary validData4 = {0xFF, 0x88, 0x12, 20, 1, 81};
+    EXPECT_EQ(validData4, msgEncode.scroll(ScrollType::LINE1_RIGHT_STEP, 20));
+}
+
+TEST(MessageEncoder, stopScroll)
+{
+    MessageEncoder msgEncode;
+    Binary validData = {0xFF, 0x88, 0xFF, 10, 1, 109};
+    EXPECT_EQ(validData, msgEncode.stopScroll());
 }
 
 TEST(MessageEncoder, lampTest)
@@ -0,0 +1,73 @@
+#include "ipl_timeline.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace panel;
+using namespace std::chrono_literals;
+
+using Clock = IplTimeline::Clock;
+
+TEST(IplTimeline, phaseDurations)
+{
+    IplTimeline timeline;
+    const auto start = Clock::now();
+
+    EXPECT_FALSE(timeline.isIplInProgress());
+    EXPECT_TRUE(timeline.getCurrentIplPhases(start).empty());
+
+    timeline.recordProgressCode("C1001F00", start);
+    timeline.recordProgressCode("C1001FFF", start + 2s);
+    timeline.recordProgressCode("C7004091", start + 5s);
+    timeline.recordProgressCode("CA000040", start + 12s);
+    EXPECT_TRUE(timeline.isIplInProgress());
+
+    // last phase is measured till now while the IPL is in progress.
+    IplTimeline::PhaseDurations expected = {
+        {"C1", 5000}, {"C7", 7000}, {"CA", 1000}};
+    EXPECT_EQ(expected, timeline.getCurrentIplPhases(start + 13s));
+
+    timeline.endIpl(start + 20s);
+    EXPECT_FALSE(timeline.isIplInProgress());
+
+    expected = {{"C1", 5000}, {"C7", 7000}, {"CA", 8000}};
+    EXPECT_EQ(expected, timeline.getCurrentIplPhases(start + 60s));
+    EXPECT_TRUE(timeline.getPreviousIplPhases().empty());
+}
+
+TEST(IplTimeline, nextIpl)
+{
+    IplTimeline timeline;
+    const auto start = Clock::now();
+
+    timeline.recordProgressCode("C1001F00", start);
+    timeline.recordProgressCode("C7004091", start + 3s);
+    timeline.endIpl(start + 4s);
+
+    // First code after the end of an IPL starts the next IPL.
+    timeline.recordProgressCode("C1001F00", start + 100s);
+    EXPECT_TRUE(timeline.isIplInProgress());
+
+    IplTimeline::PhaseDurations expected = {{"C1", 3000}, {"C7", 1000}};
+    EXPECT_EQ(expected, timeline.getPreviousIplPhases());
+
+    expected = {{"C1", 1000}};
+    EXPECT_EQ(expected, timeline.getCurrentIplPhases(start + 101s));
+}
+
+TEST(IplTimeline, reIpl)
+{
+    IplTimeline timeline;
+    const auto start = Clock::now();
+
+    timeline.recordProgressCode("C1001F00", start);
+    timeline.recordProgressCode("C7004091", start + 3s);
+    timeline.recordProgressCode("C7004092", start + 6s);
+
+    // Going back to the first phase restarts the IPL, the aborted IPL ends
+    // with its last progress code.
+    timeline.recordProgressCode("C1001F00", start + 50s);
+
+    IplTimeline::PhaseDurations expected = {{"C1", 3000}, {"C7", 3000}};
+    EXPECT_EQ(expected, timeline.getPreviousIplPhases());
+    EXPECT_TRUE(timeline.isIplInProgress());
+}
@@ -0,0 +1,71 @@
+#include "logger.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace panel::log;
+
+class LoggerTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        Logger::getInstance().setSink(
+            [this](const Entry& entry) { entries.push_back(entry); });
+        Logger::getInstance().setLevel(Level::INFO);
+    }
+
+    void TearDown() override
+    {
+        Logger::getInstance().attach(nullptr);
+        Logger::getInstance().setSink(nullptr);
+        Logger::getInstance().setLevel(compiledLevel);
+    }
+
+    std::vector<Entry> entries;
+};
+
+TEST_F(LoggerTest, levelFilter)
+{
+    Logger::getInstance().setLevel(Category::TRANSPORT, Level::WARNING);
+
+    info(Category::TRANSPORT, "filtered");
+    warning(Category::TRANSPORT, "key ", 1);
+    info(Category::STATE, "function ", 21);
+
+    ASSERT_EQ(2u, entries.size());
+    EXPECT_EQ("key 1", entries[0].message);
+    EXPECT_EQ(Level::WARNING, entries[0].level);
+    EXPECT_EQ("function 21", entries[1].message);
+    EXPECT_EQ(Category::STATE, entries[1].category);
+}
+
+TEST_F(LoggerTest, compiledOut)
+{
+    Logger::getInstance().setLevel(Level::DEBUG);
+    debug(Category::STATE, "state ", 2);
+
+    // debug statements are compiled in only if log-level option is debug.
+    EXPECT_EQ(compiledLevel >= Level::DEBUG, !entries.empty());
+}
+
+TEST_F(LoggerTest, batching)
+{
+    auto io = std::make_shared<boost::asio::io_context>();
+    Logger::getInstance().attach(io);
+
+    info(Category::BUS, "first");
+    info(Category::BUS, "second");
+    EXPECT_TRUE(entries.empty());
+
+    // batch is written out after the current event.
+    io->run();
+    ASSERT_EQ(2u, entries.size());
+    EXPECT_EQ("first", entries[0].message);
+
+    // errors are written right away, along with the batch before them.
+    info(Category::BUS, "third");
+    error(Category::BUS, "failure");
+    ASSERT_EQ(4u, entries.size());
+    EXPECT_EQ("third", entries[2].message);
+    EXPECT_EQ("failure", entries[3].message);
+}
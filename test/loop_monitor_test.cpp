@@ -0,0 +1,50 @@
+#include "loop_monitor.hpp"
+#include "metrics.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace panel;
+using namespace std::chrono_literals;
+
+TEST(LoopMonitor, slowHandler)
+{
+    LoopMonitor::recordHandler("fastHandler", 1ms);
+    LoopMonitor::recordHandler("slowHandler", 60ms);
+    LoopMonitor::recordHandler("slowHandler", 80ms);
+
+    const auto& slowHandlers = LoopMonitor::getSlowHandlers();
+    EXPECT_EQ(slowHandlers.end(), slowHandlers.find("fastHandler"));
+
+    const auto it = slowHandlers.find("slowHandler");
+    ASSERT_NE(slowHandlers.end(), it);
+    EXPECT_EQ(2u, std::get<0>(it->second));
+    EXPECT_EQ(80000u, std::get<1>(it->second));
+}
+
+TEST(LoopMonitor, lagProbe)
+{
+    auto io = std::make_shared<boost::asio::io_context>();
+    LoopMonitor monitor(io, 10ms);
+    monitor.start();
+
+    const auto before = std::get<1>(metrics::get().loopLag.getSnapshot());
+
+    // keep the loop busy past the probe expiry.
+    boost::asio::steady_timer blocker(*io, 1ms);
+    blocker.async_wait([](const boost::system::error_code&) {
+        LoopMonitor::HandlerScope scope("blockingHandler");
+        const auto end = LoopMonitor::Clock::now() + 60ms;
+        while (LoopMonitor::Clock::now() < end)
+        {
+        }
+    });
+
+    io->run_for(100ms);
+    monitor.stop();
+
+    const auto [buckets, count, sum, max] =
+        metrics::get().loopLag.getSnapshot();
+    EXPECT_LT(before, count);
+    EXPECT_LE(40000u, max);
+    EXPECT_EQ(1u, LoopMonitor::getSlowHandlers().count("blockingHandler"));
+}
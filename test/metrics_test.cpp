@@ -0,0 +1,89 @@
+#include "metrics.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace panel::metrics;
+using namespace std::chrono_literals;
+
+TEST(Metrics, histogramBuckets)
+{
+    Histogram histogram;
+    histogram.observe(10);
+    histogram.observe(50);
+    histogram.observe(51);
+    histogram.observe(2ms);
+    histogram.observe(5s);
+
+    const auto [buckets, count, sum, max] = histogram.getSnapshot();
+    ASSERT_EQ(Histogram::bounds.size() + 1, buckets.size());
+
+    // a value equal to the bound is in the bucket of that bound.
+    EXPECT_EQ(2u, buckets[0]);
+    EXPECT_EQ(1u, buckets[1]);
+    EXPECT_EQ(1u, buckets[5]);
+    EXPECT_EQ(1u, buckets.back());
+    EXPECT_EQ(5u, count);
+    EXPECT_EQ(10u + 50u + 51u + 2000u + 5000000u, sum);
+    EXPECT_EQ(5000000u, max);
+}
+
+TEST(Metrics, dbusCallLatency)
+{
+    auto& metrics = Metrics::getInstance();
+
+    auto& pldm = metrics.getDbusCallLatency("xyz.openbmc_project.PLDM");
+    EXPECT_EQ(&pldm, &metrics.getDbusCallLatency("xyz.openbmc_project.PLDM"));
+    EXPECT_NE(&pldm, &metrics.getDbusCallLatency("xyz.openbmc_project.Dump"));
+
+    // calls of the other tests are recorded in the same histogram.
+    const auto before = std::get<1>(pldm.getSnapshot());
+    {
+        CallTimer timer(pldm);
+    }
+
+    const auto histograms = metrics.getHistograms();
+    const auto it = histograms.find("dbus_call_us:xyz.openbmc_project.PLDM");
+    ASSERT_NE(histograms.end(), it);
+    EXPECT_EQ(before + 1, std::get<1>(it->second));
+}
+
+TEST(Metrics, counters)
+{
+    auto& metrics = Metrics::getInstance();
+    const auto before = metrics.getCounters().at("frames_written");
+
+    metrics.framesWritten.increment();
+    metrics.framesWritten.increment(2);
+
+    EXPECT_EQ(before + 3, metrics.getCounters().at("frames_written"));
+}
+
+TEST(Metrics, gauge)
+{
+    Gauge gauge;
+    gauge.set(5);
+    gauge.add();
+    gauge.sub(3);
+    EXPECT_EQ(3, gauge.get());
+
+    // updates from several threads are not lost.
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([&gauge]() {
+            for (size_t count = 0; count < 10000; ++count)
+            {
+                gauge.add(2);
+                gauge.sub();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(3 + 4 * 10000, gauge.get());
+}
@@ -0,0 +1,50 @@
+#include "platform.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace panel;
+using namespace panel::platform;
+
+// platforms are resolved at compile time as well.
+static_assert(findPlatform("00000000").im == tacoma.im);
+
+TEST(Platform, unknownIm)
+{
+    const auto& platform = findPlatform("00000000");
+    EXPECT_EQ(&tacoma, &platform);
+    EXPECT_EQ(constants::tacomaLcdDevPath, platform.lcd.devPath);
+    EXPECT_TRUE(platform.lcd.dbusObj.empty());
+    EXPECT_FALSE(platform.base);
+
+    // empty IM when it could not be read.
+    EXPECT_EQ(&tacoma, &findPlatform(""));
+}
+
+#ifdef PANEL_PLATFORM_RAINIER
+TEST(Platform, rainier)
+{
+    for (const auto im :
+         {constants::rain2s2uIM, constants::rain2s4uIM, constants::rain1s4uIM})
+    {
+        const auto& platform = findPlatform(im);
+        EXPECT_EQ(im, platform.im);
+        EXPECT_EQ(constants::rainLcdDevPath, platform.lcd.devPath);
+        EXPECT_EQ(constants::rainLcdDbusObj, platform.lcd.dbusObj);
+        ASSERT_TRUE(platform.base);
+        EXPECT_EQ(constants::rainBaseDbusObj, platform.base->dbusObj);
+        EXPECT_EQ(constants::rainInputDevPath, platform.inputDevPath);
+    }
+}
+#endif
+
+#ifdef PANEL_PLATFORM_EVEREST
+TEST(Platform, everest)
+{
+    const auto& platform = findPlatform(constants::everestIM);
+    EXPECT_EQ(constants::everLcdDevPath, platform.lcd.devPath);
+    EXPECT_EQ(constants::everLcdDbusObj, platform.lcd.dbusObj);
+    ASSERT_TRUE(platform.base);
+    EXPECT_EQ(constants::everBaseDbusObj, platform.base->dbusObj);
+    EXPECT_EQ(constants::everInputDevPath, platform.inputDevPath);
+}
+#endif
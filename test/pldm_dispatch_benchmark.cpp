@@ -0,0 +1,119 @@
+#include "pldm_fw.hpp"
+#include "pldm_responder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace panel;
+using namespace std::chrono_literals;
+using panel::test::PldmResponder;
+using Clock = std::chrono::steady_clock;
+
+/* Number of functions dispatched per run. */
+static constexpr size_t requestCount = 1000;
+
+/**
+ * @brief Dispatch functions to the responder, keeping the given number of
+ * them in flight, and print the throughput and latency.
+ * @param[in] hostDelay - Time taken by the host to respond.
+ * @param[in] window - Max number of functions in flight.
+ * @return false if the run could not complete.
+ */
+static bool runDispatch(std::chrono::microseconds hostDelay, size_t window)
+{
+    PldmResponder::Options options;
+    options.responseDelay = hostDelay;
+    PldmResponder responder(options);
+
+    auto io = std::make_shared<boost::asio::io_context>();
+    auto conn = responder.connect(*io);
+    PldmFramework pldm(io, conn,
+                       [&responder]() { return responder.openMctpSocket(); });
+
+    std::vector<Clock::duration> latencies;
+    latencies.reserve(requestCount);
+    size_t sent = 0;
+    size_t failed = 0;
+
+    std::function<void()> sendNext = [&]() {
+        const auto sentAt = Clock::now();
+        pldm.sendPanelFunctionToPhyp(
+            static_cast<types::FunctionNumber>(21 + sent % 2),
+            [&, sentAt](PldmStatus status, types::Byte) {
+                latencies.push_back(Clock::now() - sentAt);
+                if (status != PldmStatus::SUCCESS)
+                {
+                    failed++;
+                }
+                if (sent < requestCount)
+                {
+                    sendNext();
+                }
+            });
+        sent++;
+    };
+
+    const auto start = Clock::now();
+    for (size_t count = 0; count < window && sent < requestCount; ++count)
+    {
+        sendNext();
+    }
+
+    const auto deadline = start + 60s;
+    while (latencies.size() < requestCount && Clock::now() < deadline)
+    {
+        io->restart();
+        io->run_for(10ms);
+    }
+    const auto elapsed = Clock::now() - start;
+
+    if (latencies.size() < requestCount || failed)
+    {
+        std::cerr << "Run failed, completed = " << latencies.size()
+                  << ", failed = " << failed << std::endl;
+        return false;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    auto toUs = [](Clock::duration duration) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+            .count();
+    };
+
+    const auto seconds = std::chrono::duration<double>(elapsed).count();
+    std::cout << "host delay " << std::setw(5) << hostDelay.count()
+              << " us, window " << std::setw(2) << window << ": "
+              << std::setw(8) << std::fixed << std::setprecision(1)
+              << requestCount / seconds << " req/s, p50 " << std::setw(6)
+              << toUs(latencies[latencies.size() / 2]) << " us, p99 "
+              << std::setw(6) << toUs(latencies[latencies.size() * 99 / 100])
+              << " us" << std::endl;
+    return true;
+}
+
+int main()
+{
+    try
+    {
+        for (const auto hostDelay : {0us, 1000us})
+        {
+            for (const size_t window : {1, 2, 4, 8})
+            {
+                if (!runDispatch(hostDelay, window))
+                {
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,265 @@
+#include "pldm_fw.hpp"
+#include "pldm_responder.hpp"
+
+#include <libpldm/base.h>
+
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+using namespace panel;
+using namespace std::chrono_literals;
+using panel::test::PldmResponder;
+
+class PldmFrameworkTest : public ::testing::Test
+{
+  protected:
+    // Start the responder, returns false if it could not be started.
+    bool start(const PldmResponder::Options& options = {})
+    {
+        pldm.reset();
+        conn.reset();
+        responder.reset();
+        statuses.clear();
+
+        try
+        {
+            responder = std::make_unique<PldmResponder>(options);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            return false;
+        }
+
+        io = std::make_shared<boost::asio::io_context>();
+        conn = responder->connect(*io);
+        pldm = std::make_unique<PldmFramework>(
+            io, conn, [this]() { return responder->openMctpSocket(); });
+        return true;
+    }
+
+    void send(types::FunctionNumber function)
+    {
+        pldm->sendPanelFunctionToPhyp(
+            function, [this](PldmStatus status, types::Byte) {
+                statuses.push_back(status);
+            });
+    }
+
+    // Run the event loop till the given number of requests complete.
+    bool waitForCompletions(size_t count)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + 10s;
+        while (statuses.size() < count &&
+               std::chrono::steady_clock::now() < deadline)
+        {
+            io->restart();
+            io->run_for(10ms);
+        }
+        return statuses.size() >= count;
+    }
+
+    // Run the event loop till the host receives the given number of requests.
+    bool waitForReceived(size_t count)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + 10s;
+        while (responder->getReceivedFunctions().size() < count &&
+               std::chrono::steady_clock::now() < deadline)
+        {
+            io->restart();
+            io->run_for(10ms);
+        }
+        return responder->getReceivedFunctions().size() >= count;
+    }
+
+    std::unique_ptr<PldmResponder> responder;
+    std::shared_ptr<boost::asio::io_context> io;
+    std::shared_ptr<sdbusplus::asio::connection> conn;
+    std::unique_ptr<PldmFramework> pldm;
+    std::vector<PldmStatus> statuses;
+};
+
+TEST_F(PldmFrameworkTest, sendFunction)
+{
+    if (!start())
+    {
+        GTEST_SKIP() << "PLDM responder could not be started.";
+    }
+    send(21);
+
+    ASSERT_TRUE(waitForCompletions(1));
+    EXPECT_EQ(PldmStatus::SUCCESS, statuses.front());
+    EXPECT_EQ(std::vector<types::FunctionNumber>{21},
+              responder->getReceivedFunctions());
+}
+
+TEST_F(PldmFrameworkTest, completionError)
+{
+    PldmResponder::Options options;
+    options.completionCode = PLDM_ERROR_NOT_READY;
+    if (!start(options))
+    {
+        GTEST_SKIP() << "PLDM responder could not be started.";
+    }
+    send(65);
+
+    ASSERT_TRUE(waitForCompletions(1));
+    EXPECT_EQ(PldmStatus::COMPLETION_ERROR, statuses.front());
+}
+
+TEST_F(PldmFrameworkTest, pipelinedRequests)
+{
+    PldmResponder::Options options;
+    options.responseDelay = 20ms;
+    if (!start(options))
+    {
+        GTEST_SKIP() << "PLDM responder could not be started.";
+    }
+
+    // all are sent before the first response arrives.
+    send(21);
+    send(22);
+    send(34);
+    ASSERT_TRUE(waitForReceived(3));
+    EXPECT_EQ(3u, responder->getInstanceIdRequestCount());
+
+    ASSERT_TRUE(waitForCompletions(3));
+    EXPECT_EQ(std::vector<PldmStatus>(3, PldmStatus::SUCCESS), statuses);
+
+    std::vector<types::FunctionNumber> expected{21, 22, 34};
+    EXPECT_EQ(expected, responder->getReceivedFunctions());
+
+    // PDR is looked up once for all the requests.
+    EXPECT_EQ(1u, responder->getPdrRequestCount());
+}
+
+TEST_F(PldmFrameworkTest, pdrCacheInvalidation)
+{
+    if (!start())
+    {
+        GTEST_SKIP() << "PLDM responder could not be started.";
+    }
+    send(21);
+    ASSERT_TRUE(waitForCompletions(1));
+
+    pldm->invalidatePdrCache();
+    send(22);
+    ASSERT_TRUE(waitForCompletions(2));
+
+    EXPECT_EQ(2u, responder->getPdrRequestCount());
+}
+
+TEST_F(PldmFrameworkTest, transportError)
+{
+    PldmResponder::Options options;
+    options.dropResponses = true;
+    if (!start(options))
+    {
+        GTEST_SKIP() << "PLDM responder could not be started.";
+    }
+    send(41);
+    ASSERT_TRUE(waitForReceived(1));
+
+    // host goes away with the request in flight.
+    responder->stop();
+
+    ASSERT_TRUE(waitForCompletions(1));
+    EXPECT_EQ(PldmStatus::TRANSPORT_ERROR, statuses.front());
+}
+
+TEST_F(PldmFrameworkTest, socketOpenFailure)
+{
+    if (!start())
+    {
+        GTEST_SKIP() << "PLDM responder could not be started.";
+    }
+
+    // the socket fails to open for the first request only.
+    bool failOpen = true;
+    pldm = std::make_unique<PldmFramework>(io, conn, [this, &failOpen]() {
+        if (failOpen)
+        {
+            failOpen = false;
+            return -1;
+        }
+        return responder->openMctpSocket();
+    });
+
+    send(21);
+    ASSERT_TRUE(waitForCompletions(1));
+    EXPECT_EQ(PldmStatus::REQUEST_ERROR, statuses.front());
+
+    // the id allocated for the unsent request is used for the next one.
+    send(22);
+    ASSERT_TRUE(waitForCompletions(2));
+    EXPECT_EQ(PldmStatus::SUCCESS, statuses.back());
+    EXPECT_EQ(1u, responder->getInstanceIdRequestCount());
+    EXPECT_EQ(std::vector<types::FunctionNumber>{22},
+              responder->getReceivedFunctions());
+}
+
+TEST_F(PldmFrameworkTest, compositeEffecters)
+{
+    // possible states of variable length precede the panel state set.
+    PldmResponder::Options options;
+    options.compositeStateSets = {1, 2, PldmResponder::stateIdToEnablePanelFunc,
+                                  3};
+    if (!start(options))
+    {
+        GTEST_SKIP() << "PLDM responder could not be started.";
+    }
+    send(66);
+
+    ASSERT_TRUE(waitForCompletions(1));
+    EXPECT_EQ(PldmStatus::SUCCESS, statuses.front());
+    EXPECT_EQ(std::vector<types::FunctionNumber>{66},
+              responder->getReceivedFunctions());
+}
+
+TEST_F(PldmFrameworkTest, malformedPdr)
+{
+    PldmResponder::Options noPanelStateSet;
+    noPanelStateSet.compositeStateSets = {1, 2};
+
+    PldmResponder::Options tooManyEffecters;
+    tooManyEffecters.compositeStateSets = std::vector<uint16_t>(
+        9, PldmResponder::stateIdToEnablePanelFunc);
+
+    PldmResponder::Options truncated;
+    truncated.compositeStateSets = {1,
+                                    PldmResponder::stateIdToEnablePanelFunc};
+    truncated.pdrTruncation = 2;
+
+    for (const auto& options : {noPanelStateSet, tooManyEffecters, truncated})
+    {
+        if (!start(options))
+        {
+            GTEST_SKIP() << "PLDM responder could not be started.";
+        }
+        send(21);
+        ASSERT_TRUE(waitForCompletions(1));
+        EXPECT_EQ(PldmStatus::REQUEST_ERROR, statuses.front());
+        EXPECT_TRUE(responder->getReceivedFunctions().empty());
+    }
+}
+
+TEST(PldmFramework, pdrRepublished)
+{
+    using types::BootProgress;
+
+    // PDRs stay the same through the steps of the IPL.
+    EXPECT_FALSE(PldmFramework::isPdrRepublished(
+        BootProgress::PRIMARY_PROC_INIT, BootProgress::MEMORY_INIT));
+    EXPECT_FALSE(PldmFramework::isPdrRepublished(
+        BootProgress::SYSTEM_INIT_COMPLETE, BootProgress::OS_START));
+    EXPECT_FALSE(PldmFramework::isPdrRepublished(BootProgress::OS_RUNNING,
+                                                 BootProgress::OS_RUNNING));
+
+    EXPECT_TRUE(PldmFramework::isPdrRepublished(BootProgress::OS_START,
+                                                BootProgress::OS_RUNNING));
+    EXPECT_TRUE(PldmFramework::isPdrRepublished(
+        BootProgress::OS_RUNNING, BootProgress::PRIMARY_PROC_INIT));
+    EXPECT_TRUE(PldmFramework::isPdrRepublished(BootProgress::MEMORY_INIT,
+                                                BootProgress::UNSPECIFIED));
+}
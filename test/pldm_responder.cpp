@@ -0,0 +1,361 @@
+#include "pldm_responder.hpp"
+
+#include <libpldm/base.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <sdbusplus/asio/object_server.hpp>
+#include <stdexcept>
+
+namespace panel::test
+{
+/* MCTP message prefix: eid and message type. */
+static constexpr size_t mctpPrefixSize = 2;
+static constexpr auto mctpMsgTypePldm = (types::Byte)1;
+
+/* Number of instance ids PLDM allows per terminus. */
+static constexpr auto maxInstanceIds = (types::Byte)32;
+
+PldmResponder::PldmResponder(const Options& options) : options(options)
+{
+    void* memory = mmap(nullptr, sizeof(SharedData), PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+    {
+        throw std::runtime_error("Failed to map responder shared data.");
+    }
+    shared = new (memory) SharedData;
+
+    int sockets[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sockets) == -1)
+    {
+        throw std::runtime_error("Failed to create MCTP socket pair.");
+    }
+    requesterFd = sockets[0];
+    endpointFd = sockets[1];
+
+    int ready[2];
+    if (pipe(ready) == -1)
+    {
+        throw std::runtime_error("Failed to create pipe.");
+    }
+
+    responderPid = fork();
+    if (responderPid == -1)
+    {
+        throw std::runtime_error("Failed to fork responder.");
+    }
+
+    if (responderPid == 0)
+    {
+        close(ready[0]);
+        close(requesterFd);
+        try
+        {
+            runResponder(ready[1]);
+        }
+        catch (const std::exception&)
+        {
+            // parent finds the ready pipe closed.
+            _exit(EXIT_FAILURE);
+        }
+    }
+
+    close(ready[1]);
+    close(endpointFd);
+    endpointFd = -1;
+
+    // wait till the responder is on the bus.
+    char byte = 0;
+    auto length = read(ready[0], &byte, sizeof(byte));
+    close(ready[0]);
+    if (length != sizeof(byte))
+    {
+        throw std::runtime_error("Responder failed to start.");
+    }
+}
+
+PldmResponder::PldmResponder() : PldmResponder(Options{})
+{
+}
+
+PldmResponder::~PldmResponder()
+{
+    stop();
+
+    if (requesterFd != -1)
+    {
+        close(requesterFd);
+    }
+
+    shared->~SharedData();
+    munmap(shared, sizeof(SharedData));
+}
+
+std::shared_ptr<sdbusplus::asio::connection>
+    PldmResponder::connect(boost::asio::io_context& io) const
+{
+    return bus.connect(io);
+}
+
+int PldmResponder::openMctpSocket() const
+{
+    return dup(requesterFd);
+}
+
+void PldmResponder::stop()
+{
+    if (responderPid > 0)
+    {
+        kill(responderPid, SIGTERM);
+        waitpid(responderPid, nullptr, 0);
+        responderPid = -1;
+    }
+}
+
+std::vector<types::FunctionNumber> PldmResponder::getReceivedFunctions() const
+{
+    std::vector<types::FunctionNumber> functions;
+    const auto count =
+        std::min<size_t>(shared->functionCount, maxRecordedFunctions);
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        functions.push_back(shared->functions[index]);
+    }
+    return functions;
+}
+
+types::PldmPacket PldmResponder::buildPanelEffecterPdr() const
+{
+    const size_t statesOffset =
+        offsetof(pldm_state_effecter_pdr, possible_states);
+
+    // state set id and possible states size, preceding the possible states.
+    constexpr size_t possibleStatesHdrSize = 3;
+
+    size_t pdrSize = statesOffset;
+    for (size_t pos = 0; pos < options.compositeStateSets.size(); ++pos)
+    {
+        pdrSize += possibleStatesHdrSize + 1 + pos % 3;
+    }
+
+    types::PldmPacket pdr(pdrSize);
+
+    auto effecterPdr = reinterpret_cast<pldm_state_effecter_pdr*>(pdr.data());
+    effecterPdr->hdr.type = PLDM_STATE_EFFECTER_PDR;
+    effecterPdr->hdr.length = pdr.size() - sizeof(pldm_pdr_hdr);
+    effecterPdr->terminus_handle = phypTerminusID;
+    effecterPdr->effecter_id = panelEffecterId;
+    effecterPdr->entity_type = frontPanelBoardEntityId;
+    effecterPdr->composite_effecter_count = options.compositeStateSets.size();
+
+    auto possibleStates = pdr.begin() + statesOffset;
+    for (size_t pos = 0; pos < options.compositeStateSets.size(); ++pos)
+    {
+        const auto stateSetId = options.compositeStateSets[pos];
+        const auto possibleStatesSize = 1 + pos % 3;
+
+        *possibleStates++ = stateSetId & 0xFF;
+        *possibleStates++ = stateSetId >> 8;
+        *possibleStates++ = possibleStatesSize;
+
+        // all states possible
+        possibleStates = std::fill_n(possibleStates, possibleStatesSize, 0xFF);
+    }
+
+    pdr.resize(pdr.size() - std::min(options.pdrTruncation, pdr.size()));
+    return pdr;
+}
+
+void PldmResponder::runResponder(int readyFd)
+{
+    boost::asio::io_context io;
+    auto conn = connect(io);
+    conn->request_name("xyz.openbmc_project.PLDM");
+
+    sdbusplus::asio::object_server server(conn);
+
+    auto pdrIface = server.add_interface("/xyz/openbmc_project/pldm",
+                                         "xyz.openbmc_project.PLDM.PDR");
+    pdrIface->register_method(
+        "FindStateEffecterPDR",
+        [this](uint8_t terminusId, uint16_t entityId, uint16_t stateSetId) {
+            shared->pdrRequests++;
+
+            std::vector<types::PldmPacket> pdrs;
+            if (terminusId == phypTerminusID &&
+                entityId == frontPanelBoardEntityId &&
+                stateSetId == stateIdToEnablePanelFunc)
+            {
+                pdrs.emplace_back(buildPanelEffecterPdr());
+            }
+            return pdrs;
+        });
+    pdrIface->initialize();
+
+    auto requesterIface = server.add_interface(
+        "/xyz/openbmc_project/pldm", "xyz.openbmc_project.PLDM.Requester");
+    requesterIface->register_method("GetInstanceId", [this](uint8_t) {
+        shared->instanceIdRequests++;
+
+        const auto instanceId = nextInstanceId;
+        nextInstanceId = (nextInstanceId + 1) % maxInstanceIds;
+        return instanceId;
+    });
+    requesterIface->initialize();
+
+    auto assetIface = server.add_interface(
+        panelObject, "xyz.openbmc_project.Inventory.Decorator.Asset");
+    assetIface->register_property("SerialNumber",
+                                  std::string(panelSerialNumber));
+    assetIface->register_property("Model", std::string(panelModel));
+    assetIface->initialize();
+
+    auto itemIface =
+        server.add_interface(panelObject, "xyz.openbmc_project.Inventory.Item");
+    itemIface->register_property("PrettyName", std::string(panelName));
+    itemIface->register_property("Present", true);
+    itemIface->initialize();
+
+    boost::asio::posix::stream_descriptor endpoint(io, endpointFd);
+    std::function<void()> waitForRequest = [&]() {
+        endpoint.async_wait(
+            boost::asio::posix::stream_descriptor::wait_read,
+            [&](const boost::system::error_code& ec) {
+                if (ec)
+                {
+                    io.stop();
+                    return;
+                }
+                serveMctpRequest(io);
+                waitForRequest();
+            });
+    };
+    waitForRequest();
+
+    char byte = 1;
+    [[maybe_unused]] auto length = write(readyFd, &byte, sizeof(byte));
+    close(readyFd);
+
+    io.run();
+    _exit(EXIT_SUCCESS);
+}
+
+std::optional<types::FunctionNumber> PldmResponder::decodePanelFunction(
+    std::span<const set_effecter_state_field> stateFields) const
+{
+    if (stateFields.size() != options.compositeStateSets.size())
+    {
+        return std::nullopt;
+    }
+
+    std::optional<types::FunctionNumber> function;
+    for (size_t pos = 0; pos < stateFields.size(); ++pos)
+    {
+        const bool isPanel =
+            options.compositeStateSets[pos] == stateIdToEnablePanelFunc &&
+            !function;
+
+        if (isPanel && stateFields[pos].set_request == PLDM_REQUEST_SET)
+        {
+            function = stateFields[pos].effecter_state;
+        }
+        else if (stateFields[pos].set_request != PLDM_NO_CHANGE)
+        {
+            return std::nullopt;
+        }
+    }
+    return function;
+}
+
+void PldmResponder::serveMctpRequest(boost::asio::io_context& io)
+{
+    std::array<types::Byte, 64> request{};
+    auto length = recv(endpointFd, request.data(), request.size(), 0);
+    if (length <= 0)
+    {
+        // panel app closed the socket.
+        io.stop();
+        return;
+    }
+
+    if (static_cast<size_t>(length) < mctpPrefixSize + sizeof(pldm_msg_hdr))
+    {
+        return;
+    }
+
+    auto requestMsg =
+        reinterpret_cast<const pldm_msg*>(request.data() + mctpPrefixSize);
+
+    uint16_t effecterId = 0;
+    types::Byte effecterCount = 0;
+    std::array<set_effecter_state_field, 8> stateFields{};
+
+    types::Byte completionCode = options.completionCode;
+    if (decode_set_state_effecter_states_req(
+            requestMsg, length - mctpPrefixSize - sizeof(pldm_msg_hdr),
+            &effecterId, &effecterCount,
+            stateFields.data()) != PLDM_SUCCESS ||
+        effecterId != panelEffecterId)
+    {
+        completionCode = PLDM_ERROR_INVALID_DATA;
+    }
+    else if (auto function = decodePanelFunction(
+                 std::span(stateFields.data(), effecterCount)))
+    {
+        const auto index = shared->functionCount++;
+        if (index < maxRecordedFunctions)
+        {
+            shared->functions[index] = *function;
+        }
+    }
+    else
+    {
+        completionCode = PLDM_ERROR_INVALID_DATA;
+    }
+
+    if (options.dropResponses)
+    {
+        return;
+    }
+
+    constexpr size_t responseSize = mctpPrefixSize + sizeof(pldm_msg_hdr) +
+                                    PLDM_SET_STATE_EFFECTER_STATES_RESP_BYTES;
+    auto response = std::make_shared<std::array<types::Byte, responseSize>>();
+    (*response)[0] = mctpEid;
+    (*response)[1] = mctpMsgTypePldm;
+    encode_set_state_effecter_states_resp(
+        requestMsg->hdr.instance_id, completionCode,
+        reinterpret_cast<pldm_msg*>(response->data() + mctpPrefixSize));
+
+    auto respond = [this, response]() {
+        send(endpointFd, response->data(), response->size(), MSG_NOSIGNAL);
+    };
+
+    if (options.responseDelay.count() == 0)
+    {
+        respond();
+        return;
+    }
+
+    auto timer = std::make_shared<boost::asio::steady_timer>(io);
+    timer->expires_after(options.responseDelay);
+    timer->async_wait([timer, respond](const boost::system::error_code& ec) {
+        if (!ec)
+        {
+            respond();
+        }
+    });
+}
+} // namespace panel::test
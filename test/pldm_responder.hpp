@@ -0,0 +1,201 @@
+#pragma once
+
+#include "private_bus.hpp"
+#include "types.hpp"
+
+#include <libpldm/platform.h>
+#include <sys/types.h>
+
+#include <array>
+#include <atomic>
+#include <boost/asio/io_context.hpp>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <sdbusplus/asio/connection.hpp>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace panel::test
+{
+/** @class PldmResponder
+ * @brief A local stand-in for pldmd and the host.
+ *
+ * It starts a private D-Bus daemon and, in a child process, serves
+ * FindStateEffecterPDR and GetInstanceId on it as pldmd would. The child also
+ * acts as the host MCTP endpoint on one end of a socket pair. It decodes the
+ * SetStateEffecterStates requests, records the panel function in them and
+ * responds with the configured completion code. Asset and Item interfaces of
+ * an inventory object are served as well, to read properties from.
+ *
+ * PldmFramework is pointed at it with connect() and openMctpSocket().
+ */
+class PldmResponder
+{
+  public:
+    /* Constants pldmd and host use for the panel effecter. */
+    static constexpr auto mctpEid = (types::Byte)9;
+    static constexpr auto phypTerminusID = (types::Byte)208;
+    static constexpr auto frontPanelBoardEntityId = (uint16_t)32837;
+    static constexpr auto stateIdToEnablePanelFunc = (uint16_t)32778;
+    static constexpr auto panelEffecterId = (uint16_t)0x1234;
+
+    /* Inventory object served with the properties of a panel. */
+    static constexpr auto panelObject =
+        "/xyz/openbmc_project/inventory/system/chassis/panel0";
+    static constexpr auto panelSerialNumber = "YL1234567890";
+    static constexpr auto panelModel = "6B58";
+    static constexpr auto panelName = "Operator Panel";
+
+    /* Max number of functions recorded. */
+    static constexpr size_t maxRecordedFunctions = 4096;
+
+    /**
+     * @brief Behaviour of the responder.
+     */
+    struct Options
+    {
+        // State set ids of the composite effecters of the panel effecter PDR.
+        // Possible states of the composite effecters are 1, 2 and 3 bytes
+        // long in turn.
+        std::vector<uint16_t> compositeStateSets{stateIdToEnablePanelFunc};
+
+        // Number of bytes to be cut from the end of the PDR.
+        size_t pdrTruncation = 0;
+
+        // Completion code of the responses.
+        types::Byte completionCode = 0;
+
+        // Time taken by the host to respond.
+        std::chrono::microseconds responseDelay{0};
+
+        // If requests are to be left without response.
+        bool dropResponses = false;
+    };
+
+    /* Deleted Api's*/
+    PldmResponder(const PldmResponder&) = delete;
+    PldmResponder& operator=(const PldmResponder&) = delete;
+    PldmResponder(PldmResponder&&) = delete;
+
+    /**
+     * @brief Constructor
+     * Starts the D-Bus daemon and the responder process.
+     * @param[in] options - Behaviour of the responder.
+     * @throw std::runtime_error if the responder could not be started.
+     */
+    explicit PldmResponder(const Options& options);
+
+    /**
+     * @brief Constructor
+     * Starts a responder with the default behaviour.
+     */
+    PldmResponder();
+
+    /**
+     * @brief Destructor
+     * Stops the responder process and the D-Bus daemon.
+     */
+    ~PldmResponder();
+
+    /**
+     * @brief Api to connect to the private bus.
+     * @param[in] io - io_context to attach the connection to.
+     * @return Bus connection.
+     */
+    std::shared_ptr<sdbusplus::asio::connection>
+        connect(boost::asio::io_context& io) const;
+
+    /**
+     * @brief Api to open the MCTP socket to the responder.
+     * To be passed to PldmFramework as the MCTP socket opener.
+     * @return Socket fd, -1 on failure.
+     */
+    int openMctpSocket() const;
+
+    /**
+     * @brief Api to stop the responder process.
+     * Requests in flight are left without response and the MCTP socket is
+     * closed on them.
+     */
+    void stop();
+
+    /** @brief Number of FindStateEffecterPDR calls served. */
+    inline size_t getPdrRequestCount() const
+    {
+        return shared->pdrRequests;
+    }
+
+    /** @brief Number of GetInstanceId calls served. */
+    inline size_t getInstanceIdRequestCount() const
+    {
+        return shared->instanceIdRequests;
+    }
+
+    /**
+     * @brief Api to get the panel functions received by the host.
+     * @return Functions, in the order they were received.
+     */
+    std::vector<types::FunctionNumber> getReceivedFunctions() const;
+
+  private:
+    /**
+     * @brief Data shared with the responder process.
+     */
+    struct SharedData
+    {
+        std::atomic<uint32_t> pdrRequests{0};
+        std::atomic<uint32_t> instanceIdRequests{0};
+        std::atomic<uint32_t> functionCount{0};
+        std::array<std::atomic<types::FunctionNumber>, maxRecordedFunctions>
+            functions{};
+    };
+
+    /**
+     * @brief Main of the responder process.
+     * @param[in] readyFd - fd to notify once the responder is on the bus.
+     */
+    [[noreturn]] void runResponder(int readyFd);
+
+    /**
+     * @brief Api to build the panel effecter PDR.
+     * @return PDR data.
+     */
+    types::PldmPacket buildPanelEffecterPdr() const;
+
+    /**
+     * @brief Api to decode the panel function from a request.
+     * Host accepts the request only if the panel state set is the one set.
+     * @param[in] stateFields - State fields of the request.
+     * @return Panel function, empty if the request is not valid.
+     */
+    std::optional<types::FunctionNumber> decodePanelFunction(
+        std::span<const set_effecter_state_field> stateFields) const;
+
+    /**
+     * @brief Api to serve a request received on the MCTP socket.
+     * @param[in] io - io_context of the responder process.
+     */
+    void serveMctpRequest(boost::asio::io_context& io);
+
+    /* Behaviour of the responder. */
+    Options options;
+
+    /* Private bus pldmd is served on. */
+    PrivateBus bus;
+
+    /* Responder process pid */
+    pid_t responderPid = -1;
+
+    /* MCTP socket ends of panel app and of the responder. */
+    int requesterFd = -1;
+    int endpointFd = -1;
+
+    /* Data shared with the responder process. */
+    SharedData* shared = nullptr;
+
+    /* Instance id given out by GetInstanceId. */
+    types::Byte nextInstanceId = 0;
+};
+} // namespace panel::test
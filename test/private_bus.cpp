@@ -0,0 +1,73 @@
+#include "private_bus.hpp"
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <stdexcept>
+
+namespace panel::test
+{
+PrivateBus::PrivateBus()
+{
+    int address[2];
+    if (pipe(address) == -1)
+    {
+        throw std::runtime_error("Failed to create pipe.");
+    }
+
+    busDaemonPid = fork();
+    if (busDaemonPid == -1)
+    {
+        throw std::runtime_error("Failed to fork D-Bus daemon.");
+    }
+
+    if (busDaemonPid == 0)
+    {
+        close(address[0]);
+        const auto printAddress =
+            "--print-address=" + std::to_string(address[1]);
+        execlp("dbus-daemon", "dbus-daemon", "--session", "--nofork",
+               printAddress.c_str(), nullptr);
+        _exit(EXIT_FAILURE);
+    }
+
+    close(address[1]);
+
+    // daemon prints the address once it is ready to accept connections.
+    char byte = 0;
+    while (read(address[0], &byte, sizeof(byte)) == sizeof(byte) &&
+           byte != '\n')
+    {
+        busAddress.push_back(byte);
+    }
+    close(address[0]);
+
+    if (busAddress.empty())
+    {
+        kill(busDaemonPid, SIGTERM);
+        waitpid(busDaemonPid, nullptr, 0);
+        throw std::runtime_error("Failed to start D-Bus daemon.");
+    }
+
+    // session bus of this process and its children is the private bus.
+    setenv("DBUS_SESSION_BUS_ADDRESS", busAddress.c_str(), 1);
+}
+
+PrivateBus::~PrivateBus()
+{
+    if (busDaemonPid > 0)
+    {
+        kill(busDaemonPid, SIGTERM);
+        waitpid(busDaemonPid, nullptr, 0);
+    }
+}
+
+std::shared_ptr<sdbusplus::asio::connection>
+    PrivateBus::connect(boost::asio::io_context& io) const
+{
+    return std::make_shared<sdbusplus::asio::connection>(
+        io, sdbusplus::bus::new_user().release());
+}
+} // namespace panel::test
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <boost/asio/io_context.hpp>
+#include <memory>
+#include <sdbusplus/asio/connection.hpp>
+#include <string>
+
+namespace panel::test
+{
+/** @class PrivateBus
+ * @brief A private D-Bus daemon for the tests.
+ *
+ * The daemon is started in the constructor and becomes the session bus of
+ * the process and of the children forked afterwards, so the tests do not
+ * depend on a system bus.
+ */
+class PrivateBus
+{
+  public:
+    /* Deleted Api's*/
+    PrivateBus(const PrivateBus&) = delete;
+    PrivateBus& operator=(const PrivateBus&) = delete;
+    PrivateBus(PrivateBus&&) = delete;
+
+    /**
+     * @brief Constructor
+     * Starts the D-Bus daemon.
+     * @throw std::runtime_error if the daemon could not be started.
+     */
+    PrivateBus();
+
+    /**
+     * @brief Destructor
+     * Stops the D-Bus daemon.
+     */
+    ~PrivateBus();
+
+    /**
+     * @brief Api to connect to the private bus.
+     * @param[in] io - io_context to attach the connection to.
+     * @return Bus connection.
+     */
+    std::shared_ptr<sdbusplus::asio::connection>
+        connect(boost::asio::io_context& io) const;
+
+  private:
+    /* Address of the private bus. */
+    std::string busAddress;
+
+    /* D-Bus daemon pid */
+    pid_t busDaemonPid = -1;
+};
+} // namespace panel::test
@@ -0,0 +1,57 @@
+#include "progress_code_decoder.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace panel;
+using namespace panel::decoder;
+
+// ASCII "C7004091" with first character in the least significant byte.
+static constexpr uint64_t primaryCode = 0x3139303430303743;
+
+TEST(ProgressCodeDecoder, referenceCodeOnly)
+{
+    const auto progressCode = decodeProgressCode(primaryCode, types::Binary{});
+    EXPECT_EQ("C7004091", progressCode.fullSrc());
+    EXPECT_EQ("C7004091", progressCode.referenceCode());
+    EXPECT_TRUE(progressCode.hexWords().empty());
+
+    // Secondary data having just the SRC header carries no hex word.
+    const auto headerOnly =
+        decodeProgressCode(primaryCode, types::Binary(8, 0x02));
+    EXPECT_EQ("C7004091", headerOnly.fullSrc());
+    EXPECT_TRUE(headerOnly.hexWords().empty());
+}
+
+TEST(ProgressCodeDecoder, hexWords)
+{
+    types::Binary secondaryCode(8, 0x00);
+    // hex word 2 and 3
+    secondaryCode.insert(secondaryCode.end(),
+                         {0x0A, 0x20, 0x00, 0x00, 0x12, 0x3F, 0xBC, 0xD9});
+
+    const auto progressCode = decodeProgressCode(primaryCode, secondaryCode);
+    EXPECT_EQ("C7004091 0A200000 123FBCD9", progressCode.fullSrc());
+    EXPECT_EQ("C7004091", progressCode.referenceCode());
+    EXPECT_EQ("0A200000 123FBCD9", progressCode.hexWords());
+
+    // Incomplete trailing hex word is ignored.
+    secondaryCode.push_back(0xFF);
+    EXPECT_EQ("C7004091 0A200000 123FBCD9",
+              decodeProgressCode(primaryCode, secondaryCode).fullSrc());
+}
+
+TEST(ProgressCodeDecoder, maxHexWords)
+{
+    // Header followed by 9 hex words, only hex word 2 to 9 are decoded.
+    types::Binary secondaryCode(8, 0x00);
+    for (types::Byte word = 0; word < 9; ++word)
+    {
+        secondaryCode.insert(secondaryCode.end(), {0xFE, 0xDC, 0xBA, word});
+    }
+
+    const auto progressCode = decodeProgressCode(primaryCode, secondaryCode);
+    EXPECT_EQ(ProgressCode::maxSrcLength, progressCode.fullSrc().length());
+    EXPECT_EQ("C7004091 FEDCBA00 FEDCBA01 FEDCBA02 FEDCBA03 FEDCBA04 FEDCBA05 "
+              "FEDCBA06 FEDCBA07",
+              progressCode.fullSrc());
+}
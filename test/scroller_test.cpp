@@ -0,0 +1,78 @@
+#include "metrics.hpp"
+#include "scroller.hpp"
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace panel;
+using namespace std::chrono_literals;
+
+class ScrollerTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        io = std::make_shared<boost::asio::io_context>();
+
+        // frames written to the missing device are counted as suppressed.
+        transport = std::make_shared<Transport>(
+            io, "/dev/panel-test-missing", 0x5a, types::PanelType::BASE);
+        transport->setTransportKey(true);
+
+        scroller = std::make_unique<Scroller>(io, transport);
+        scroller->setSettings(0, {20ms, 40ms});
+        scroller->setSettings(1, {60ms, 40ms});
+    }
+
+    uint64_t getFrames() const
+    {
+        return metrics::get().framesSuppressed.get();
+    }
+
+    std::shared_ptr<boost::asio::io_context> io;
+    std::shared_ptr<Transport> transport;
+    std::unique_ptr<Scroller> scroller;
+};
+
+TEST_F(ScrollerTest, hardwareScroll)
+{
+    EXPECT_FALSE(Scroller::isNeeded(std::string(80, 'A'), "LINE 2"));
+    EXPECT_TRUE(Scroller::isNeeded("LINE 1", std::string(81, 'A')));
+}
+
+TEST_F(ScrollerTest, independentLines)
+{
+    std::string line1 = "U78DA.ND0.WZS0042-P0-C5-T0";
+    line1 += std::string(80, '.');
+    const std::string line2 = "0123456789ABCDEFGHIJKLMNOP";
+
+    scroller->start(line1, line2);
+    EXPECT_TRUE(scroller->isScrolling());
+    EXPECT_EQ(line1.substr(0, 16), scroller->getView(0));
+    EXPECT_EQ(line2.substr(0, 16), scroller->getView(1));
+
+    // pause at the start, then line 1 moves twice as fast as line 2.
+    io->run_for(40ms + 130ms);
+    const auto offset1 = line1.find(scroller->getView(0));
+    const auto offset2 = line2.find(scroller->getView(1));
+    EXPECT_GT(offset2, 0u);
+    EXPECT_GT(offset1, offset2);
+
+    scroller->stop();
+    const auto view = scroller->getView(0);
+    io->run_for(100ms);
+    EXPECT_FALSE(scroller->isScrolling());
+    EXPECT_EQ(view, scroller->getView(0));
+}
+
+TEST_F(ScrollerTest, changedFramesOnly)
+{
+    const auto framesBefore = getFrames();
+
+    // every view of the line is the same, only the first is written.
+    scroller->start(std::string(100, 'A'), "LINE 2");
+    io->run_for(200ms);
+    EXPECT_EQ(framesBefore + 1, getFrames());
+}
@@ -0,0 +1,97 @@
+#include "timer_wheel.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace panel;
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+TEST(TimerWheel, expiryOrder)
+{
+    boost::asio::io_context io;
+    TimerWheel::Timer first(io, "first");
+    TimerWheel::Timer second(io, "second");
+    TimerWheel::Timer third(io, "third");
+
+    std::vector<std::string> expired;
+    const auto start = Clock::now();
+    third.expiresAfter(60ms, [&]() { expired.push_back("third"); });
+    first.expiresAfter(20ms, [&]() { expired.push_back("first"); });
+    second.expiresAfter(40ms, [&]() { expired.push_back("second"); });
+    EXPECT_TRUE(first.isPending());
+
+    io.run();
+    EXPECT_EQ((std::vector<std::string>{"first", "second", "third"}), expired);
+    EXPECT_GE(Clock::now() - start, 60ms);
+    EXPECT_FALSE(first.isPending());
+}
+
+TEST(TimerWheel, cancel)
+{
+    boost::asio::io_context io;
+    TimerWheel::Timer cancelled(io, "cancelled");
+    auto destroyed = std::make_unique<TimerWheel::Timer>(io, "destroyed");
+    TimerWheel::Timer rescheduled(io, "rescheduled");
+
+    size_t count = 0;
+    cancelled.expiresAfter(20ms, [&]() { count += 1; });
+    destroyed->expiresAfter(20ms, [&]() { count += 10; });
+    rescheduled.expiresAfter(20ms, [&]() { count += 100; });
+    rescheduled.expiresAfter(30ms, [&]() { count += 1000; });
+
+    cancelled.cancel();
+    destroyed.reset();
+    EXPECT_FALSE(cancelled.isPending());
+
+    io.run();
+    EXPECT_EQ(1000u, count);
+}
+
+TEST(TimerWheel, cascade)
+{
+    boost::asio::io_context io;
+    TimerWheel::Timer longTimer(io, "long");
+    TimerWheel::Timer shortTimer(io, "short");
+
+    // beyond the 64 ticks of the first level.
+    Clock::time_point longExpiry{};
+    const auto start = Clock::now();
+    longTimer.expiresAfter(700ms, [&]() { longExpiry = Clock::now(); });
+
+    // rescheduled from its own callback.
+    size_t ticks = 0;
+    std::function<void()> tick = [&]() {
+        if (++ticks < 3)
+        {
+            shortTimer.expiresAfter(10ms, tick);
+        }
+    };
+    shortTimer.expiresAfter(10ms, tick);
+
+    io.run();
+    EXPECT_EQ(3u, ticks);
+    EXPECT_GE(longExpiry - start, 700ms);
+    EXPECT_LT(longExpiry - start, 700ms + 200ms);
+}
+
+TEST(TimerWheel, pendingTimers)
+{
+    boost::asio::io_context io;
+    TimerWheel::Timer lampTest(io, "lampTest");
+    TimerWheel::Timer scroll(io, "scrollStep");
+
+    lampTest.expiresAfter(240s, []() {});
+    scroll.expiresAfter(300ms, []() {});
+
+    const auto pending =
+        boost::asio::use_service<TimerWheel>(io).getPendingTimers();
+    ASSERT_EQ(2u, pending.size());
+    EXPECT_EQ("scrollStep", std::get<0>(pending[0]));
+    EXPECT_LE(std::get<1>(pending[0]), 310u);
+    EXPECT_EQ("lampTest", std::get<0>(pending[1]));
+    EXPECT_GT(std::get<1>(pending[1]), 239000u);
+}
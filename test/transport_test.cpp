@@ -0,0 +1,91 @@
+#include "i2c_message_encoder.hpp"
+#include "metrics.hpp"
+#include "transport.hpp"
+
+#include <chrono>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace panel;
+using namespace std::chrono_literals;
+
+TEST(Transport, reopenWithBackoff)
+{
+    auto io = std::make_shared<boost::asio::io_context>();
+    auto& metrics = metrics::get();
+    const auto downBefore = metrics.transportsDown.get();
+    const auto attemptsBefore =
+        metrics.getCounters().at("transport_recovery_attempts");
+
+    // the device can not be opened, the app keeps running.
+    auto transport = std::make_unique<Transport>(
+        io, "/dev/panel-test-missing", 0x5a, types::PanelType::BASE);
+    EXPECT_FALSE(transport->isHealthy());
+    EXPECT_EQ(downBefore + 1, metrics.transportsDown.get());
+
+    // writes are held back till the device is reopened.
+    const auto suppressedBefore = metrics.framesSuppressed.get();
+    transport->setTransportKey(true);
+    transport->panelI2CWrite(
+        encoder::MessageEncoder().rawDisplay("LINE 1", "LINE 2"));
+    EXPECT_EQ(suppressedBefore + 1, metrics.framesSuppressed.get());
+
+    // each failed attempt doubles the delay before the next one.
+    EXPECT_EQ(Transport::minRecoveryDelay, transport->getRecoveryDelay());
+    for (auto attempt = 1; attempt <= 3; ++attempt)
+    {
+        const auto attempts = attemptsBefore + attempt;
+        while (metrics.getCounters().at("transport_recovery_attempts") <
+               attempts)
+        {
+            ASSERT_NE(0u, io->run_one_for(10s));
+        }
+        EXPECT_EQ(Transport::minRecoveryDelay * (1 << attempt),
+                  transport->getRecoveryDelay());
+    }
+    EXPECT_FALSE(transport->isHealthy());
+
+    transport.reset();
+    EXPECT_EQ(downBefore, metrics.transportsDown.get());
+}
+
+TEST(Transport, recoveryBackoff)
+{
+    std::vector<std::chrono::milliseconds> delays{Transport::minRecoveryDelay};
+    while (delays.back() < Transport::maxRecoveryDelay)
+    {
+        delays.push_back(Transport::nextRecoveryDelay(delays.back()));
+    }
+
+    // doubled till capped at the max.
+    const std::vector<std::chrono::milliseconds> expected{
+        100ms, 200ms, 400ms, 800ms, 1600ms, 3200ms, 6400ms, 12800ms, 25600ms,
+        30000ms};
+    EXPECT_EQ(expected, delays);
+    EXPECT_EQ(Transport::maxRecoveryDelay,
+              Transport::nextRecoveryDelay(Transport::maxRecoveryDelay));
+}
+
+TEST(Transport, detachWhileAttaching)
+{
+    auto io = std::make_shared<boost::asio::io_context>();
+    Transport transport(io, "/dev/panel-test-missing", 0x5a,
+                        types::PanelType::LCD);
+
+    const auto suppressedBefore = metrics::get().framesSuppressed.get();
+    transport.attach(std::chrono::steady_clock::now());
+    EXPECT_TRUE(transport.isTransportKeyEnabled());
+
+    // displays are held back while the panel is initialised.
+    transport.panelI2CWrite(
+        encoder::MessageEncoder().rawDisplay("LINE 1", "LINE 2"));
+    EXPECT_EQ(suppressedBefore + 1, metrics::get().framesSuppressed.get());
+
+    transport.detach();
+    EXPECT_FALSE(transport.isTransportKeyEnabled());
+
+    // the init of the detached panel is not completed.
+    io->run_for(Transport::softResetDelay * 2);
+    EXPECT_FALSE(transport.isTransportKeyEnabled());
+}
@@ -0,0 +1,102 @@
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace panel;
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+/* Number of button presses per run. */
+static constexpr size_t pressCount = 200;
+
+/* Interval between the button presses. */
+static constexpr auto pressInterval = 5ms;
+
+/* Time taken by a blocking call of the executor. */
+static constexpr auto callDuration = 20ms;
+
+/**
+ * @brief Press buttons while the executor keeps a blocking call running, and
+ * print the latency of the button presses.
+ * @param[in] loaded - If executor calls run during the presses.
+ */
+static void runPresses(bool loaded)
+{
+    auto io = std::make_shared<boost::asio::io_context>();
+    WorkerPool workers(io);
+
+    std::vector<Clock::duration> latencies;
+    latencies.reserve(pressCount);
+    size_t calls = 0;
+
+    // keep one blocking call in flight, like a user executing functions.
+    std::function<void()> executeNext = [&]() {
+        calls++;
+        workers.submit([]() { std::this_thread::sleep_for(callDuration); },
+                       [&](std::exception_ptr) {
+                           if (latencies.size() < pressCount)
+                           {
+                               executeNext();
+                           }
+                       });
+    };
+    if (loaded)
+    {
+        executeNext();
+    }
+
+    // a press is handled when the loop gets to it.
+    boost::asio::steady_timer timer(*io);
+    std::function<void()> pressNext = [&]() {
+        timer.expires_after(pressInterval);
+        timer.async_wait([&](const boost::system::error_code&) {
+            const auto pressedAt = timer.expiry();
+            boost::asio::post(*io, [&, pressedAt]() {
+                latencies.push_back(Clock::now() - pressedAt);
+                if (latencies.size() < pressCount)
+                {
+                    pressNext();
+                }
+            });
+        });
+    };
+    pressNext();
+
+    while (latencies.size() < pressCount)
+    {
+        io->restart();
+        io->run_for(10ms);
+    }
+    // let the call in flight complete before the pool goes away.
+    io->restart();
+    io->run_for(2 * callDuration);
+
+    std::sort(latencies.begin(), latencies.end());
+    auto toUs = [](Clock::duration duration) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+            .count();
+    };
+
+    std::cout << std::left << std::setw(10) << (loaded ? "loaded" : "idle")
+              << " calls " << std::setw(5) << calls << " p50 "
+              << std::setw(8) << toUs(latencies[pressCount / 2]) << " p99 "
+              << std::setw(8) << toUs(latencies[pressCount * 99 / 100])
+              << " max " << toUs(latencies.back()) << " us" << std::endl;
+}
+
+int main()
+{
+    std::cout << "Button latency, worker threads "
+              << (WorkerPool::isThreaded() ? "on" : "off") << std::endl;
+
+    runPresses(false);
+    runPresses(true);
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "exception.hpp"
+#include "worker_pool.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace panel;
+using namespace std::chrono_literals;
+
+TEST(WorkerPool, completionOrder)
+{
+    auto io = std::make_shared<boost::asio::io_context>();
+    std::vector<int> completed;
+
+    {
+        WorkerPool workers(io, 4);
+
+        // first work finishes last, its completion must still run first.
+        for (int index = 0; index < 4; ++index)
+        {
+            workers.submit(
+                [index]() {
+                    std::this_thread::sleep_for((4 - index) * 5ms);
+                },
+                [&completed, index](std::exception_ptr error) {
+                    EXPECT_FALSE(error);
+                    completed.push_back(index);
+                });
+        }
+
+        while (completed.size() < 4)
+        {
+            io->restart();
+            io->run_for(10ms);
+        }
+    }
+
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3}), completed);
+}
+
+TEST(WorkerPool, workFailure)
+{
+    auto io = std::make_shared<boost::asio::io_context>();
+    WorkerPool workers(io);
+    bool failed = false;
+
+    workers.submit([]() { throw FunctionFailure("call failed"); },
+                   [&failed](std::exception_ptr error) {
+                       ASSERT_TRUE(error);
+                       try
+                       {
+                           std::rethrow_exception(error);
+                       }
+                       catch (const FunctionFailure& e)
+                       {
+                           failed = true;
+                           EXPECT_STREQ("call failed", e.what());
+                       }
+                   });
+
+    while (!failed)
+    {
+        io->restart();
+        io->run_for(10ms);
+    }
+    EXPECT_TRUE(failed);
+}